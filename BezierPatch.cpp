@@ -0,0 +1,110 @@
+#include "BezierPatch.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define BEZIER_SSE
+#endif
+
+BezierPatch::BezierPatch(const glm::vec3 control_net[4][4])
+{
+	for (int row = 0; row < 4; row++)
+	{
+		for (int column = 0; column < 4; column++)
+		{
+			this->net[row][column] = control_net[row][column];
+		}
+	}
+	this->basis_level_of_detail = 0;
+}
+
+/* Work out the cubic weights for every sample: t^3, 3t^2(1 - t), 3t(1 - t)^2 and (1 - t)^3. Padded to a multiple of four with zero weights. */
+void BezierPatch::setupBasis(int level_of_detail)
+{
+	if (level_of_detail == basis_level_of_detail)
+		return;
+	basis_level_of_detail = level_of_detail;
+	int padded = (level_of_detail + 3) & ~3;
+	for (int k = 0; k < 4; k++)
+	{
+		basis[k].assign(padded, 0.0f);
+	}
+	for (int s = 0; s < level_of_detail; s++)
+	{
+		float t = (float)s / (level_of_detail - 1);
+		float it = 1.0f - t;
+		basis[0][s] = t*t*t;
+		basis[1][s] = 3 * t*t*it;
+		basis[2][s] = 3 * t*it*it;
+		basis[3][s] = it*it*it;
+	}
+}
+
+/* Evaluate a single point, for when a whole tessellation isn't needed. */
+glm::vec3 BezierPatch::evaluate(float u, float v)
+{
+	float iu = 1.0f - u;
+	float iv = 1.0f - v;
+	float bu[4] = { u*u*u, 3 * u*u*iu, 3 * u*iu*iu, iu*iu*iu };
+	float bv[4] = { v*v*v, 3 * v*v*iv, 3 * v*iv*iv, iv*iv*iv };
+	glm::vec3 point(0.0f);
+	for (int row = 0; row < 4; row++)
+	{
+		glm::vec3 curve = bu[0] * net[row][0] + bu[1] * net[row][1] + bu[2] * net[row][2] + bu[3] * net[row][3];
+		point += bv[row] * curve;
+	}
+	return point;
+}
+
+/* Tessellate the patch. Each row of output (fixed u) reduces the net to four points, then the row is those points times the v basis. */
+void BezierPatch::tessellate(int level_of_detail, std::vector<glm::vec3> &vertices)
+{
+	vertices.resize(level_of_detail * level_of_detail);
+	if (level_of_detail < 2)
+	{
+		if (level_of_detail == 1)
+			vertices[0] = evaluate(0.0f, 0.0f);
+		return;
+	}
+	setupBasis(level_of_detail);
+	const float * b[4] = { &basis[0][0], &basis[1][0], &basis[2][0], &basis[3][0] };
+	for (int i = 0; i < level_of_detail; i++)
+	{
+		//The four row curves at u_i, the u basis for sample i is the same table.
+		glm::vec3 curve[4];
+		for (int row = 0; row < 4; row++)
+		{
+			curve[row] = b[0][i] * net[row][0] + b[1][i] * net[row][1] + b[2][i] * net[row][2] + b[3][i] * net[row][3];
+		}
+		glm::vec3 * out = &vertices[i * level_of_detail];
+		int j = 0;
+#ifdef BEZIER_SSE
+		//Four samples at a time, x, y and z are worked out separately then written back as points.
+		__m128 cx[4], cy[4], cz[4];
+		for (int row = 0; row < 4; row++)
+		{
+			cx[row] = _mm_set1_ps(curve[row].x);
+			cy[row] = _mm_set1_ps(curve[row].y);
+			cz[row] = _mm_set1_ps(curve[row].z);
+		}
+		for (; j + 4 <= level_of_detail; j += 4)
+		{
+			__m128 w0 = _mm_loadu_ps(b[0] + j);
+			__m128 w1 = _mm_loadu_ps(b[1] + j);
+			__m128 w2 = _mm_loadu_ps(b[2] + j);
+			__m128 w3 = _mm_loadu_ps(b[3] + j);
+			float x[4], y[4], z[4];
+			_mm_storeu_ps(x, _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, cx[0]), _mm_mul_ps(w1, cx[1])), _mm_add_ps(_mm_mul_ps(w2, cx[2]), _mm_mul_ps(w3, cx[3]))));
+			_mm_storeu_ps(y, _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, cy[0]), _mm_mul_ps(w1, cy[1])), _mm_add_ps(_mm_mul_ps(w2, cy[2]), _mm_mul_ps(w3, cy[3]))));
+			_mm_storeu_ps(z, _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, cz[0]), _mm_mul_ps(w1, cz[1])), _mm_add_ps(_mm_mul_ps(w2, cz[2]), _mm_mul_ps(w3, cz[3]))));
+			for (int k = 0; k < 4; k++)
+			{
+				out[j + k] = glm::vec3(x[k], y[k], z[k]);
+			}
+		}
+#endif
+		for (; j < level_of_detail; j++)
+		{
+			out[j] = (b[0][j] * curve[0] + b[1][j] * curve[1]) + (b[2][j] * curve[2] + b[3][j] * curve[3]);
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef BEZIERPATCH_H
+#define BEZIERPATCH_H
+
+#include "Window.h"
+
+/* A bicubic Bezier patch from any 4x4 control net. Tessellating evaluates the four row curves once per u, then every v along the row is a small product of those curves with a basis table that's only worked out again when the level of detail changes. */
+class BezierPatch
+{
+private:
+	//Control net, net[row][column]. Row r is weighted by the v basis and column c by the u basis.
+	glm::vec3 net[4][4];
+	//Cubic basis for every sample at level_of_detail, one array per weight so rows can run four samples at a time.
+	std::vector<float> basis[4];
+	int basis_level_of_detail;
+	void setupBasis(int level_of_detail);
+
+public:
+	BezierPatch(const glm::vec3 control_net[4][4]);
+	//Point on the patch, the first control point of a row or column has weight t^3.
+	glm::vec3 evaluate(float u, float v);
+	//level_of_detail * level_of_detail points, u runs down the rows (i * level_of_detail + j is (u_i, v_j)).
+	void tessellate(int level_of_detail, std::vector<glm::vec3> &vertices);
+};
+#endif
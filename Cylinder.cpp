@@ -1,13 +1,13 @@
-#include "Cylinder.h"
-#include "OBJObject.h"
-
-/* Initialize the object, parse it and set up buffers. */
-Cylinder::Cylinder(OBJObject * obj)
-{
-	this->toDraw = obj;
-}
-
-/* Deconstructor to safely delete when finished. */
-Cylinder::~Cylinder()
-{
+#include "Cylinder.h"
+#include "OBJObject.h"
+
+/* Initialize the object, parse it and set up buffers. */
+Cylinder::Cylinder(OBJObject * obj)
+{
+	this->toDraw = obj;
+}
+
+/* Deconstructor to safely delete when finished. */
+Cylinder::~Cylinder()
+{
 }
\ No newline at end of file
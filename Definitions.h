@@ -1,75 +1,165 @@
-#pragma once
-
+#pragma once
+
 #ifndef DEFINITIONS_H
 #define DEFINITIONS_H
-
-/* Container: [X, Y, Z] [R, G, B] [S, T] */
-struct Container {
-	//Position
-	glm::vec3 vertex;
-	//Normal
-	glm::vec3 normal;
-	//TexCoords
-	glm::vec2 texCoord;
-};
-
-/* Texture Container to hold certain textures. */
-struct Texture {
-	GLuint id;
-	std::string type;
-};
-
-struct Material {//Setup the object's material.
-	glm::vec3 ambient;
-	glm::vec3 diffuse;
-	glm::vec3 specular;
-	float shininess;
-};
-
-struct DirLight {//Directional Light
-	bool on;
-	glm::vec3 direction;
-	glm::vec3 ambient;
-	glm::vec3 diffuse;
-	glm::vec3 specular;
-};
-
-struct PointLight {//Point Light
-	bool on;
-	glm::vec3 position;
-	glm::vec3 ambient;
-	glm::vec3 diffuse;
-	glm::vec3 specular;
-	float quadratic;
-};
-
-struct SpotLight {//Spot Light
-	bool on;
-	glm::vec3 position;
-	glm::vec3 ambient;
-	glm::vec3 diffuse;
-	glm::vec3 specular;
-	float quadratic;
-	glm::vec3 direction;
-	float spotCutoff;
-	float spotExponent;
-};
-
-struct Global_Camera {//Global Camera.
-	glm::vec3 position;
-	glm::vec3 lookat;
-	glm::vec3 up;
-	glm::vec3 direction;
-	glm::vec3 right;
-};
-
-struct Particles_struct {
-	glm::vec3 Position, Velocity;
-	glm::vec4 Color;
-	GLfloat Life;
-
-	Particles_struct() : Position(glm::vec3(0.0f, 0.0f, 0.0f)), Velocity(glm::vec3(0.0f, 0.0f, 0.0f)), Color(glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)), Life(1.0f) {}
-};
-
+
+/* Container: [X, Y, Z] [R, G, B] [S, T] */
+struct Container {
+	//Position
+	glm::vec3 vertex;
+	//Normal
+	glm::vec3 normal;
+	//TexCoords
+	glm::vec2 texCoord;
+};
+
+/* Terrain Container: [Y] [NX, NY, NZ] in 8 bytes. The (x, z) and (s, t) come from the vertex ID. */
+struct TerrainVertex {
+	//Height
+	float height;
+	//Normal, signed 10:10:10:2 (GL_INT_2_10_10_10_REV).
+	GLuint normal;
+};
+
+/* Texture Container to hold certain textures. */
+struct Texture {
+	GLuint id;
+	std::string type;
+};
+
+struct Material {//Setup the object's material.
+	glm::vec3 ambient;
+	glm::vec3 diffuse;
+	glm::vec3 specular;
+	float shininess;
+};
+
+struct DirLight {//Directional Light
+	bool on;
+	glm::vec3 direction;
+	glm::vec3 ambient;
+	glm::vec3 diffuse;
+	glm::vec3 specular;
+};
+
+struct PointLight {//Point Light
+	bool on;
+	glm::vec3 position;
+	glm::vec3 ambient;
+	glm::vec3 diffuse;
+	glm::vec3 specular;
+	float quadratic;
+};
+
+struct SpotLight {//Spot Light
+	bool on;
+	glm::vec3 position;
+	glm::vec3 ambient;
+	glm::vec3 diffuse;
+	glm::vec3 specular;
+	float quadratic;
+	glm::vec3 direction;
+	float spotCutoff;
+	float spotExponent;
+};
+
+struct Global_Camera {//Global Camera.
+	glm::vec3 position;
+	glm::vec3 lookat;
+	glm::vec3 up;
+	glm::vec3 direction;
+	glm::vec3 right;
+};
+
+/* Axis aligned bounding box in world space. */
+struct AABB {
+	glm::vec3 lower;
+	glm::vec3 upper;
+};
+
+/* What the frustum culling kept and skipped in the last frame, and what the horizon hid out of the rest. */
+struct Culling_stats {
+	int terrains_drawn;
+	int terrains_culled;
+	int terrains_occluded;
+	int waters_drawn;
+	int waters_culled;
+	int waters_occluded;
+	int particles_drawn;
+	int particles_culled;
+	int particles_frozen;
+	int particles_live;
+	int objects_drawn;
+	int objects_occluded;
+};
+
+/* A sculpting brush. The effect is strongest at the center and falls off smoothly to nothing at the radius. */
+enum Brush_mode { BRUSH_RAISE, BRUSH_LOWER, BRUSH_SMOOTH, BRUSH_FLATTEN };
+struct Brush {
+	int mode;
+	glm::vec3 center;
+	float radius;
+	float strength;//Height added or removed at the center for raise/lower, blend factor for smooth/flatten.
+	float target;//Height flatten pulls towards.
+};
+
+/* Small xorshift random number generator. Each user owns one, so results are reproducible and threads never share state. */
+struct Random {
+	unsigned int state;
+
+	Random(unsigned int seed) : state(seed != 0 ? seed : 1) {}
+	//Mix a seed and two coordinates into a well spread seed.
+	static unsigned int hash(unsigned int seed, int x, int z) {
+		unsigned int h = seed ^ ((unsigned int)x * 0x85EBCA6Bu) ^ ((unsigned int)z * 0xC2B2AE35u);
+		h ^= h >> 16; h *= 0x7FEB352Du;
+		h ^= h >> 15; h *= 0x846CA68Bu;
+		h ^= h >> 16;
+		return h;
+	}
+	//Next 32 random bits.
+	unsigned int next() {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+	//Uniform float in [0, 1).
+	float nextFloat() {
+		return (float)(next() >> 8) * (1.0f / 16777216.0f);
+	}
+};
+
+/* Settings for the FFT ocean. Higher resolutions and update rates look better and cost more CPU. */
+enum Ocean_spectrum { SPECTRUM_PHILLIPS, SPECTRUM_JONSWAP };
+struct Ocean_settings {
+	int resolution;//FFT size per side, a power of two from 64 to 512.
+	float update_rate;//Transforms per second, the maps are reused in between.
+	int spectrum;
+	float patch_length;//World units the simulation covers before it repeats.
+	glm::vec2 wind;//Direction and speed in m/s.
+	float fetch;//How far the wind has blown over open water in m, JONSWAP only.
+	float amplitude;//Scale on the spectrum's energy.
+	float choppiness;//Scale on the horizontal displacement that sharpens the crests, 0 leaves only heights.
+	unsigned int seed;
+
+	Ocean_settings() : resolution(256), update_rate(30.0f), spectrum(SPECTRUM_JONSWAP), patch_length(250.0f), wind(glm::vec2(6.0f, 2.0f)), fetch(20000.0f), amplitude(1.0f), choppiness(0.8f), seed(1337) {}
+};
+
+/* Settings for the particle budget. Each emitter's share of the budget falls off with its distance from the camera and is cut further while it's out of view. */
+struct Particle_budget_settings {
+	int budget;//Live particles across every emitter.
+	float falloff;//Distance at which an emitter's share has halved.
+	float freeze_distance;//Emitters further than this stop updating and aren't drawn.
+	float hidden_weight;//Scale on the share of emitters outside the frustum.
+
+	Particle_budget_settings() : budget(16000), falloff(750.0f), freeze_distance(2500.0f), hidden_weight(0.1f) {}
+};
+
+/* One particle as the instanced draw reads it: [X, Y, Z] in world space and [R, G, B, A]. */
+struct ParticleInstance {
+	glm::vec3 offset;
+	glm::vec4 color;
+};
+
 
 #endif
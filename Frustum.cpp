@@ -0,0 +1,77 @@
+#include "Frustum.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FRUSTUM_SSE
+#endif
+
+/* Start with every plane passing, so everything is visible until update is called. */
+Frustum::Frustum()
+{
+	for (int i = 0; i < 8; i++)
+	{
+		plane_a[i] = 0.0f;
+		plane_b[i] = 0.0f;
+		plane_c[i] = 0.0f;
+		plane_d[i] = 1.0f;
+	}
+}
+
+/* Extract the left, right, bottom, top, near and far planes from the rows of PV. */
+void Frustum::update(const glm::mat4 &PV)
+{
+	//glm is column major, so row i is PV[0][i], PV[1][i], PV[2][i], PV[3][i].
+	glm::vec4 row_x = glm::vec4(PV[0][0], PV[1][0], PV[2][0], PV[3][0]);
+	glm::vec4 row_y = glm::vec4(PV[0][1], PV[1][1], PV[2][1], PV[3][1]);
+	glm::vec4 row_z = glm::vec4(PV[0][2], PV[1][2], PV[2][2], PV[3][2]);
+	glm::vec4 row_w = glm::vec4(PV[0][3], PV[1][3], PV[2][3], PV[3][3]);
+	glm::vec4 planes[6] = { row_w + row_x, row_w - row_x, row_w + row_y, row_w - row_y, row_w + row_z, row_w - row_z };
+	for (int i = 0; i < 6; i++)
+	{
+		//Normalize so the plane equation gives a real distance.
+		float length = glm::length(glm::vec3(planes[i]));
+		plane_a[i] = planes[i].x / length;
+		plane_b[i] = planes[i].y / length;
+		plane_c[i] = planes[i].z / length;
+		plane_d[i] = planes[i].w / length;
+	}
+}
+
+/* Test the box's most positive corner against each plane, if it's behind any of them the whole box is outside. */
+bool Frustum::isVisible(const AABB &box)
+{
+#ifdef FRUSTUM_SSE
+	__m128 lower_x = _mm_set1_ps(box.lower.x), upper_x = _mm_set1_ps(box.upper.x);
+	__m128 lower_y = _mm_set1_ps(box.lower.y), upper_y = _mm_set1_ps(box.upper.y);
+	__m128 lower_z = _mm_set1_ps(box.lower.z), upper_z = _mm_set1_ps(box.upper.z);
+	for (int i = 0; i < 8; i += 4)
+	{
+		__m128 a = _mm_loadu_ps(plane_a + i);
+		__m128 b = _mm_loadu_ps(plane_b + i);
+		__m128 c = _mm_loadu_ps(plane_c + i);
+		//Picking the corner along each plane's normal is the larger of the two products per axis.
+		__m128 distance = _mm_loadu_ps(plane_d + i);
+		distance = _mm_add_ps(distance, _mm_max_ps(_mm_mul_ps(a, lower_x), _mm_mul_ps(a, upper_x)));
+		distance = _mm_add_ps(distance, _mm_max_ps(_mm_mul_ps(b, lower_y), _mm_mul_ps(b, upper_y)));
+		distance = _mm_add_ps(distance, _mm_max_ps(_mm_mul_ps(c, lower_z), _mm_mul_ps(c, upper_z)));
+		if (_mm_movemask_ps(_mm_cmplt_ps(distance, _mm_setzero_ps())) != 0)
+		{
+			return false;
+		}
+	}
+	return true;
+#else
+	for (int i = 0; i < 6; i++)
+	{
+		float distance = plane_d[i];
+		distance += glm::max(plane_a[i] * box.lower.x, plane_a[i] * box.upper.x);
+		distance += glm::max(plane_b[i] * box.lower.y, plane_b[i] * box.upper.y);
+		distance += glm::max(plane_c[i] * box.lower.z, plane_c[i] * box.upper.z);
+		if (distance < 0.0f)
+		{
+			return false;
+		}
+	}
+	return true;
+#endif
+}
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "Window.h"
+#include "Definitions.h"
+
+/* The six planes of the view frustum, extracted from a projection * view matrix. Boxes are tested four planes at a time. */
+class Frustum
+{
+private:
+	//Planes as a * x + b * y + c * z + d >= 0 inside, one array per component. Padded to 8 with planes that always pass.
+	float plane_a[8];
+	float plane_b[8];
+	float plane_c[8];
+	float plane_d[8];
+
+public:
+	Frustum();
+	//Extract the planes, call once per frame with Window::P * Window::V.
+	void update(const glm::mat4 &PV);
+	//True if any part of the box may be inside the frustum.
+	bool isVisible(const AABB &box);
+};
+#endif
@@ -0,0 +1,93 @@
+#include "HorizonCuller.h"
+#include <algorithm>
+
+HorizonCuller::HorizonCuller(int bins)
+{
+	this->slopes.resize(bins);
+	this->distances.resize(bins);
+	reset(glm::vec3(0.0f));
+}
+
+/* Clear the horizon: nothing is hidden until occluders are added. */
+void HorizonCuller::reset(glm::vec3 camera)
+{
+	this->camera = camera;
+	std::fill(slopes.begin(), slopes.end(), -INFINITY);
+	std::fill(distances.begin(), distances.end(), 0.0f);
+}
+
+/* Bin index for any whole number of bins, wrapping around the circle. */
+int HorizonCuller::wrap(int bin)
+{
+	int bins = (int)slopes.size();
+	return ((bin % bins) + bins) % bins;
+}
+
+/* Work out the azimuths of the box's corners relative to the direction to its center, so the range never has to wrap while it's measured. */
+bool HorizonCuller::getSpan(const AABB &box, float &start, float &end, float &nearest, float &furthest)
+{
+	//Nearest point of the box's footprint.
+	float dx = glm::max(glm::max(box.lower.x - camera.x, camera.x - box.upper.x), 0.0f);
+	float dz = glm::max(glm::max(box.lower.z - camera.z, camera.z - box.upper.z), 0.0f);
+	nearest = sqrt(dx * dx + dz * dz);
+	if (nearest <= 0.0f)
+		return false;
+	glm::vec2 center = glm::vec2(box.lower.x + box.upper.x, box.lower.z + box.upper.z) * 0.5f - glm::vec2(camera.x, camera.z);
+	float middle = atan2(center.y, center.x);
+	float low = 0.0f, high = 0.0f;
+	furthest = 0.0f;
+	for (int c = 0; c < 4; c++)
+	{
+		glm::vec2 corner = glm::vec2((c & 1) ? box.upper.x : box.lower.x, (c & 2) ? box.upper.z : box.lower.z) - glm::vec2(camera.x, camera.z);
+		float angle = atan2(corner.y, corner.x) - middle;
+		if (angle > glm::pi<float>())
+			angle -= 2.0f * glm::pi<float>();
+		if (angle < -glm::pi<float>())
+			angle += 2.0f * glm::pi<float>();
+		low = glm::min(low, angle);
+		high = glm::max(high, angle);
+		furthest = glm::max(furthest, glm::length(corner));
+	}
+	float scale = (float)slopes.size() / (2.0f * glm::pi<float>());
+	start = (middle + low) * scale;
+	end = (middle + high) * scale;
+	return true;
+}
+
+/* The box's steepest possible slope has to be at or under the horizon in every bin it touches, and the box has to be further away than the ground that set it. */
+bool HorizonCuller::isOccluded(const AABB &box)
+{
+	float start, end, nearest, furthest;
+	if (!getSpan(box, start, end, nearest, furthest))
+		return false;
+	//Above the camera the top is steepest close up, below it far away.
+	float rise = box.upper.y - camera.y;
+	float slope = rise / ((rise >= 0.0f) ? nearest : furthest);
+	for (int bin = (int)floor(start); bin <= (int)floor(end); bin++)
+	{
+		int b = wrap(bin);
+		if (slope > slopes[b] || nearest < distances[b])
+			return false;
+	}
+	return true;
+}
+
+/* Raise the horizon in the bins the box covers completely. The ground's shallowest slope is used, so the horizon never rises above the real terrain. */
+void HorizonCuller::addOccluder(const AABB &box)
+{
+	float start, end, nearest, furthest;
+	if (!getSpan(box, start, end, nearest, furthest))
+		return;
+	//Above the camera the ground is shallowest far away, below it close up.
+	float rise = box.lower.y - camera.y;
+	float slope = rise / ((rise >= 0.0f) ? furthest : nearest);
+	for (int bin = (int)ceil(start); bin < (int)floor(end); bin++)
+	{
+		int b = wrap(bin);
+		if (slope > slopes[b])
+		{
+			slopes[b] = slope;
+			distances[b] = glm::max(distances[b], furthest);
+		}
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef HORIZONCULLER_H
+#define HORIZONCULLER_H
+
+#include "Window.h"
+#include "Definitions.h"
+
+/* Conservative horizon seen from the camera, split into azimuth bins. Occluders are added front to back as boxes whose lower y the ground never drops below (terrain quadtree nodes), and anything whose box stays under the horizon in every bin it covers is hidden behind them. */
+class HorizonCuller
+{
+private:
+	//Per bin: the highest slope (rise over run from the camera) the ground is known to reach, and how far away that ground can be. Only boxes past that distance are tested against the slope.
+	std::vector<float> slopes;
+	std::vector<float> distances;
+	glm::vec3 camera;
+	//Azimuth range of the box in bins (may wrap past either end) and its nearest and furthest xz distance. False when the camera is over the box's footprint.
+	bool getSpan(const AABB &box, float &start, float &end, float &nearest, float &furthest);
+	int wrap(int bin);
+
+public:
+	//More bins hide more behind narrow gaps but cost more per occluder.
+	HorizonCuller(int bins = 512);
+	//Start a new frame with an empty horizon.
+	void reset(glm::vec3 camera);
+	//True if every part of the box is below the horizon and behind what raised it.
+	bool isOccluded(const AABB &box);
+	//Raise the horizon with ground that is at least box.lower.y everywhere inside the box's xz.
+	void addOccluder(const AABB &box);
+};
+#endif
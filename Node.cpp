@@ -1,11 +1,11 @@
-#include "Node.h"
-
-/* Define a Node Constructor amd initialize the Node. */
-Node::Node()
-{
-}
-
-/* Deconstructor to safely delete when finished. */
-Node::~Node()
-{
+#include "Node.h"
+
+/* Define a Node Constructor amd initialize the Node. */
+Node::Node()
+{
+}
+
+/* Deconstructor to safely delete when finished. */
+Node::~Node()
+{
 }
\ No newline at end of file
@@ -0,0 +1,449 @@
+#include "Ocean.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define OCEAN_SSE
+#endif
+
+#define GRAVITY 9.81f
+#define OCEAN_PI 3.14159265f
+#define MIN_RESOLUTION 64
+#define MAX_RESOLUTION 512
+//Columns per transform job, a few cache lines wide.
+#define COLUMN_BLOCK 16
+#define TRANSPOSE_TILE 16
+#define FIELDS 3
+//Phillips constant, JONSWAP peak enhancement and how much of a wave travelling against the wind is kept.
+#define PHILLIPS_ALPHA 0.0081f
+#define JONSWAP_GAMMA 3.3f
+#define AGAINST_WIND 0.07f
+//Water surface height, as in Water.cpp.
+#define HEIGHT 3.0f
+
+/* Build the spectrum and the maps for the given settings. */
+Ocean::Ocean(ThreadPool * pool, Ocean_settings settings)
+{
+	this->pool = pool;
+	//Round the resolution to a power of two in range.
+	int resolution = MIN_RESOLUTION;
+	while (resolution < settings.resolution && resolution < MAX_RESOLUTION)
+	{
+		resolution *= 2;
+	}
+	settings.resolution = resolution;
+	if (settings.update_rate <= 0.0f)
+	{
+		settings.update_rate = 1.0f;
+	}
+	this->settings = settings;
+	this->resolution = resolution;
+	this->extent = glm::vec2(0.0f);
+	this->last_update = 0.0f;
+	this->simulated = false;
+	int count = resolution * resolution;
+	for (int field = 0; field < FIELDS; field++)
+	{
+		real[field].assign(count, 0.0f);
+		imaginary[field].assign(count, 0.0f);
+	}
+	displacements.assign(count, glm::vec4(0.0f));
+	normals.assign(count, glm::vec4(0.0f, 1.0f, 0.0f, 0.0f));
+	column_extents.assign(resolution, glm::vec2(0.0f));
+	//Butterfly twiddles and the bit reversed order.
+	int bits = 0;
+	while ((1 << bits) < resolution)
+	{
+		bits++;
+	}
+	for (int k = 0; k < resolution / 2; k++)
+	{
+		twiddle_real.push_back(cos(2.0f * OCEAN_PI * k / resolution));
+		twiddle_imaginary.push_back(sin(2.0f * OCEAN_PI * k / resolution));
+	}
+	for (int i = 0; i < resolution; i++)
+	{
+		int r = 0;
+		for (int b = 0; b < bits; b++)
+		{
+			r |= ((i >> b) & 1) << (bits - 1 - b);
+		}
+		reversed.push_back(r);
+	}
+	this->buildSpectrum();
+	//Setup the maps, both tile so they repeat every patch.
+	GLuint maps[2];
+	glGenTextures(2, maps);
+	this->displacement_map = maps[0];
+	this->normal_map = maps[1];
+	for (int i = 0; i < 2; i++)
+	{
+		glBindTexture(GL_TEXTURE_2D, maps[i]);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, resolution, resolution, 0, GL_RGBA, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
+	//The vertex shader reads the displacement at level 0, the normals are mipmapped so distant water doesn't sparkle.
+	glBindTexture(GL_TEXTURE_2D, displacement_map);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, normal_map);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glGenBuffers(1, &PBO);
+}
+
+/* Deconstructor to safely delete when finished. */
+Ocean::~Ocean()
+{
+	glDeleteTextures(1, &displacement_map);
+	glDeleteTextures(1, &normal_map);
+	glDeleteBuffers(1, &PBO);
+}
+
+/* Variance of the wave vector's amplitude per unit area of wave vectors: the spectrum's energy at |k| spread around the wind direction with cos^2. */
+float Ocean::getSpectrum(float kx, float kz)
+{
+	float k = sqrt(kx * kx + kz * kz);
+	float wind_speed = glm::length(settings.wind);
+	if (k < 1e-6f || wind_speed < 1e-6f)
+		return 0.0f;
+	glm::vec2 wind_direction = settings.wind / wind_speed;
+	float cosine = (kx * wind_direction.x + kz * wind_direction.y) / k;
+	float spreading = cosine * cosine / OCEAN_PI;
+	if (cosine < 0.0f)
+	{
+		spreading *= AGAINST_WIND;
+	}
+	float energy;
+	//Largest wave the wind can sustain, waves much shorter than 1/1000 of it are damped away.
+	float largest = wind_speed * wind_speed / GRAVITY;
+	if (settings.spectrum == SPECTRUM_JONSWAP)
+	{
+		//Fetch limited spectrum over frequency, changed to wave number with the deep water dispersion w^2 = gk.
+		float frequency = sqrt(GRAVITY * k);
+		float alpha = 0.076f * pow(wind_speed * wind_speed / (settings.fetch * GRAVITY), 0.22f);
+		float peak = 22.0f * pow(GRAVITY * GRAVITY / (wind_speed * settings.fetch), 1.0f / 3.0f);
+		float sigma = (frequency <= peak) ? 0.07f : 0.09f;
+		float r = exp(-(frequency - peak) * (frequency - peak) / (2.0f * sigma * sigma * peak * peak));
+		float ratio = peak / frequency;
+		float s = alpha * GRAVITY * GRAVITY / pow(frequency, 5.0f) * exp(-1.25f * ratio * ratio * ratio * ratio) * pow(JONSWAP_GAMMA, r);
+		energy = s * (GRAVITY / (2.0f * frequency)) / k;
+	}
+	else
+	{
+		energy = PHILLIPS_ALPHA / (2.0f * k * k * k * k) * exp(-1.0f / (k * largest * k * largest));
+	}
+	float small = largest * 0.001f;
+	return settings.amplitude * energy * spreading * exp(-k * k * small * small);
+}
+
+/* Draw the random amplitude of every wave vector. Each one is seeded from its own wave vector, so the big waves stay the same when only the resolution changes. */
+void Ocean::buildSpectrum()
+{
+	int count = resolution * resolution;
+	h0.assign(count, glm::vec2(0.0f));
+	h0_conjugate.assign(count, glm::vec2(0.0f));
+	omega.assign(count, 0.0f);
+	wave_numbers.resize(resolution);
+	float dk = 2.0f * OCEAN_PI / settings.patch_length;
+	for (int i = 0; i < resolution; i++)
+	{
+		wave_numbers[i] = dk * ((i < resolution / 2) ? i : i - resolution);
+	}
+	pool->parallel_for(0, resolution, [this, dk](int i)
+	{
+		int half = resolution / 2;
+		int nz = (i < half) ? i : i - resolution;
+		for (int j = 0; j < resolution; j++)
+		{
+			//The Nyquist row and column have no matching -k and would leak between the packed fields.
+			if (i == half || j == half)
+				continue;
+			int nx = (j < half) ? j : j - resolution;
+			glm::vec2 amplitudes[2];
+			for (int side = 0; side < 2; side++)
+			{
+				int sign = side == 0 ? 1 : -1;
+				//Two unit gaussians from Box-Muller, scaled so the surface's variance is the spectrum's.
+				Random random(Random::hash(settings.seed, sign * nx, sign * nz));
+				float u1 = std::max(random.nextFloat(), 1e-7f);
+				float u2 = random.nextFloat();
+				float radius = sqrt(-2.0f * log(u1));
+				float scale = dk * sqrt(getSpectrum(sign * nx * dk, sign * nz * dk) * 0.25f);
+				amplitudes[side] = glm::vec2(radius * cos(2.0f * OCEAN_PI * u2), radius * sin(2.0f * OCEAN_PI * u2)) * scale;
+			}
+			int index = i * resolution + j;
+			h0[index] = amplitudes[0];
+			h0_conjugate[index] = glm::vec2(amplitudes[1].x, -amplitudes[1].y);
+			omega[index] = sqrt(GRAVITY * sqrt(wave_numbers[i] * wave_numbers[i] + wave_numbers[j] * wave_numbers[j]));
+		}
+	});
+}
+
+/* Advance one row of the spectrum to time, h(k, t) = h0(k) e^(iwt) + conj(h0(-k)) e^(-iwt), and write the packed fields. With D = i k / |k| h the horizontal displacement and S = i k h the slope, field 0 is h + i Dx, field 1 is Dz + i Sx and field 2 is Sz, so each transform gives two real results. */
+void Ocean::evolve(int row, float time)
+{
+	float kz = wave_numbers[row];
+	float chop = settings.choppiness;
+	for (int j = 0; j < resolution; j++)
+	{
+		int index = row * resolution + j;
+		float kx = wave_numbers[j];
+		float k = sqrt(kx * kx + kz * kz);
+		float inverse = (k > 0.0f) ? 1.0f / k : 0.0f;
+		float c = cos(omega[index] * time);
+		float s = sin(omega[index] * time);
+		glm::vec2 a = h0[index];
+		glm::vec2 b = h0_conjugate[index];
+		float h_re = (a.x + b.x) * c - (a.y - b.y) * s;
+		float h_im = (a.x - b.x) * s + (a.y + b.y) * c;
+		//i * h, shared by all four derivatives.
+		float ih_re = -h_im;
+		float ih_im = h_re;
+		float dx = chop * kx * inverse;
+		float dz = chop * kz * inverse;
+		real[0][index] = h_re - dx * ih_im;
+		imaginary[0][index] = h_im + dx * ih_re;
+		real[1][index] = dz * ih_re - kx * ih_im;
+		imaginary[1][index] = dz * ih_im + kx * ih_re;
+		real[2][index] = kz * ih_re;
+		imaginary[2][index] = kz * ih_im;
+	}
+}
+
+/* a, b = a + w * b, a - w * b for count neighbouring columns. */
+static void butterfly(float * a_re, float * a_im, float * b_re, float * b_im, float w_re, float w_im, int count)
+{
+	int c = 0;
+#ifdef OCEAN_SSE
+	__m128 wr = _mm_set1_ps(w_re);
+	__m128 wi = _mm_set1_ps(w_im);
+	for (; c + 4 <= count; c += 4)
+	{
+		__m128 ar = _mm_loadu_ps(a_re + c);
+		__m128 ai = _mm_loadu_ps(a_im + c);
+		__m128 br = _mm_loadu_ps(b_re + c);
+		__m128 bi = _mm_loadu_ps(b_im + c);
+		__m128 tr = _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+		__m128 ti = _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+		_mm_storeu_ps(a_re + c, _mm_add_ps(ar, tr));
+		_mm_storeu_ps(a_im + c, _mm_add_ps(ai, ti));
+		_mm_storeu_ps(b_re + c, _mm_sub_ps(ar, tr));
+		_mm_storeu_ps(b_im + c, _mm_sub_ps(ai, ti));
+	}
+#endif
+	for (; c < count; c++)
+	{
+		float tr = b_re[c] * w_re - b_im[c] * w_im;
+		float ti = b_re[c] * w_im + b_im[c] * w_re;
+		b_re[c] = a_re[c] - tr;
+		b_im[c] = a_im[c] - ti;
+		a_re[c] += tr;
+		a_im[c] += ti;
+	}
+}
+
+/* Inverse FFT down count columns starting at first, in place. Rows are contiguous, so every butterfly works across the neighbouring columns at once. */
+void Ocean::transformColumns(float * re, float * im, int first, int count)
+{
+	//Put the rows in bit reversed order.
+	for (int i = 0; i < resolution; i++)
+	{
+		int r = reversed[i];
+		if (r <= i)
+			continue;
+		std::swap_ranges(re + i * resolution + first, re + i * resolution + first + count, re + r * resolution + first);
+		std::swap_ranges(im + i * resolution + first, im + i * resolution + first + count, im + r * resolution + first);
+	}
+	//Merge transforms of size / 2 into transforms of size.
+	for (int size = 2; size <= resolution; size *= 2)
+	{
+		int half = size / 2;
+		int step = resolution / size;
+		for (int start = 0; start < resolution; start += size)
+		{
+			for (int k = 0; k < half; k++)
+			{
+				int a = (start + k) * resolution + first;
+				int b = a + half * resolution;
+				butterfly(re + a, im + a, re + b, im + b, twiddle_real[k * step], twiddle_imaginary[k * step], count);
+			}
+		}
+	}
+}
+
+/* Transpose one row of tiles in place, swapping it with the column of tiles that mirrors it. */
+void Ocean::transpose(float * data, int tile_row)
+{
+	int i0 = tile_row * TRANSPOSE_TILE;
+	for (int j0 = i0; j0 < resolution; j0 += TRANSPOSE_TILE)
+	{
+		for (int i = i0; i < i0 + TRANSPOSE_TILE; i++)
+		{
+			for (int j = (j0 == i0) ? i + 1 : j0; j < j0 + TRANSPOSE_TILE; j++)
+			{
+				std::swap(data[i * resolution + j], data[j * resolution + i]);
+			}
+		}
+	}
+}
+
+/* Unpack one x column of the results into the maps. After both passes the fields are transposed, so x is the row. */
+void Ocean::pack(int column)
+{
+	glm::vec2 largest(0.0f);
+	for (int z = 0; z < resolution; z++)
+	{
+		int from = column * resolution + z;
+		int to = z * resolution + column;
+		glm::vec3 displacement(imaginary[0][from], real[0][from], real[1][from]);
+		displacements[to] = glm::vec4(displacement, 0.0f);
+		normals[to] = glm::vec4(glm::normalize(glm::vec3(-imaginary[1][from], 1.0f, -real[2][from])), 0.0f);
+		largest.x = std::max(largest.x, (float)sqrt(displacement.x * displacement.x + displacement.z * displacement.z));
+		largest.y = std::max(largest.y, (float)fabs(displacement.y));
+	}
+	column_extents[column] = largest;
+}
+
+/* Advance, transform and unpack. Every step is split across the workers and each waits for the one before. */
+void Ocean::simulate(float time)
+{
+	pool->parallel_for(0, resolution, [this, time](int row)
+	{
+		evolve(row, time);
+	});
+	int blocks = resolution / COLUMN_BLOCK;
+	int tiles = resolution / TRANSPOSE_TILE;
+	//Columns, then rows by transposing and doing columns again.
+	for (int pass = 0; pass < 2; pass++)
+	{
+		pool->parallel_for(0, FIELDS * blocks, [this, blocks](int job)
+		{
+			int field = job / blocks;
+			transformColumns(&real[field][0], &imaginary[field][0], (job % blocks) * COLUMN_BLOCK, COLUMN_BLOCK);
+		});
+		if (pass == 1)
+			break;
+		pool->parallel_for(0, FIELDS * 2 * tiles, [this, tiles](int job)
+		{
+			int field = job / (2 * tiles);
+			std::vector<float> &data = ((job / tiles) % 2 == 0) ? real[field] : imaginary[field];
+			transpose(&data[0], job % tiles);
+		});
+	}
+	pool->parallel_for(0, resolution, [this](int column)
+	{
+		pack(column);
+	});
+	extent = glm::vec2(0.0f);
+	for (glm::vec2 &column : column_extents)
+	{
+		extent = glm::max(extent, column);
+	}
+}
+
+/* Stream both maps through the pixel buffer. It's orphaned first so the driver never waits on last update's copy. */
+void Ocean::upload()
+{
+	GLsizeiptr map_size = displacements.size() * sizeof(glm::vec4);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PBO);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, 2 * map_size, NULL, GL_STREAM_DRAW);
+	unsigned char * mapped = (unsigned char *)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, 2 * map_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (mapped == NULL)
+	{
+		printf("ocean: could not map the pixel buffer\n");
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return;
+	}
+	memcpy(mapped, &displacements[0], map_size);
+	memcpy(mapped + map_size, &normals[0], map_size);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	//Offsets into the bound buffer instead of pointers.
+	glBindTexture(GL_TEXTURE_2D, displacement_map);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, resolution, resolution, GL_RGBA, GL_FLOAT, (GLvoid*)0);
+	glBindTexture(GL_TEXTURE_2D, normal_map);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, resolution, resolution, GL_RGBA, GL_FLOAT, (GLvoid*)map_size);
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+/* Transform and upload when the last update is older than the update rate allows. */
+void Ocean::update(float time)
+{
+	if (simulated && time - last_update < 1.0f / settings.update_rate)
+		return;
+	this->simulate(time);
+	this->upload();
+	last_update = time;
+	simulated = true;
+}
+
+/* Return the settings, with the resolution as it was rounded. */
+Ocean_settings Ocean::getSettings()
+{
+	return settings;
+}
+
+GLuint Ocean::getDisplacementMap()
+{
+	return displacement_map;
+}
+
+GLuint Ocean::getNormalMap()
+{
+	return normal_map;
+}
+
+float Ocean::getPatchLength()
+{
+	return settings.patch_length;
+}
+
+/* Return the largest sideways and vertical displacement of the last update. */
+glm::vec2 Ocean::getExtent()
+{
+	return extent;
+}
+
+/* Return the surface height at position, bilinearly filtered like the shader's lookup. */
+float Ocean::sampleHeight(glm::vec3 position)
+{
+	//Texel centres sit half a texel in, like GL_LINEAR's.
+	float u = position.x / settings.patch_length * resolution - 0.5f;
+	float v = position.z / settings.patch_length * resolution - 0.5f;
+	int x0 = (int)floor(u);
+	int z0 = (int)floor(v);
+	float fx = u - x0;
+	float fz = v - z0;
+	//Wrap, the resolution is a power of two, which also takes x0 = -1 to the last texel.
+	int mask = resolution - 1;
+	int x1 = (x0 + 1) & mask;
+	int z1 = (z0 + 1) & mask;
+	x0 &= mask;
+	z0 &= mask;
+	float top = displacements[z0 * resolution + x0].y * (1.0f - fx) + displacements[z0 * resolution + x1].y * fx;
+	float bottom = displacements[z1 * resolution + x0].y * (1.0f - fx) + displacements[z1 * resolution + x1].y * fx;
+	return HEIGHT + top * (1.0f - fz) + bottom * fz;
+}
+
+/* Return the surface normal at position, bilinearly filtered. */
+glm::vec3 Ocean::sampleNormal(glm::vec3 position)
+{
+	float u = position.x / settings.patch_length * resolution - 0.5f;
+	float v = position.z / settings.patch_length * resolution - 0.5f;
+	int x0 = (int)floor(u);
+	int z0 = (int)floor(v);
+	float fx = u - x0;
+	float fz = v - z0;
+	int mask = resolution - 1;
+	int x1 = (x0 + 1) & mask;
+	int z1 = (z0 + 1) & mask;
+	x0 &= mask;
+	z0 &= mask;
+	glm::vec4 top = normals[z0 * resolution + x0] * (1.0f - fx) + normals[z0 * resolution + x1] * fx;
+	glm::vec4 bottom = normals[z1 * resolution + x0] * (1.0f - fx) + normals[z1 * resolution + x1] * fx;
+	return glm::normalize(glm::vec3(top * (1.0f - fz) + bottom * fz));
+}
@@ -0,0 +1,65 @@
+#pragma once
+#ifndef OCEAN_H
+#define OCEAN_H
+
+#include "Window.h"
+#include "Definitions.h"
+#include "ThreadPool.h"
+
+/* Tessendorf style ocean. A random spectrum of wave amplitudes is built once from a Phillips or JONSWAP spectrum, then every update it's advanced in time and brought back to heights, horizontal displacements and slopes with inverse FFTs on the workers. The results are streamed to a displacement map and a normal map that tile every patch_length world units. */
+class Ocean
+{
+private:
+	ThreadPool * pool;
+	Ocean_settings settings;
+	int resolution;
+	//Initial amplitudes h0(k) and conj(h0(-k)) as (real, imaginary), and the angular frequency of every wave vector, in FFT order.
+	std::vector<glm::vec2> h0;
+	std::vector<glm::vec2> h0_conjugate;
+	std::vector<float> omega;
+	//Wave number along one axis for each FFT index.
+	std::vector<float> wave_numbers;
+	//Split complex spectra, three fields of two real results each: (height, x displacement), (z displacement, x slope) and (z slope, unused).
+	std::vector<float> real[3];
+	std::vector<float> imaginary[3];
+	//exp(2 pi i k / resolution) for the butterflies and the bit reversed order of every index.
+	std::vector<float> twiddle_real;
+	std::vector<float> twiddle_imaginary;
+	std::vector<int> reversed;
+	//Displacement (x, y, z, 0) and normal (x, y, z, 0) per texel, row z, column x. Kept for sampling on the CPU.
+	std::vector<glm::vec4> displacements;
+	std::vector<glm::vec4> normals;
+	//Largest horizontal and vertical displacement of the last update, per texel column and overall.
+	std::vector<glm::vec2> column_extents;
+	glm::vec2 extent;
+	//GLSL properties. Both maps are filled from PBO.
+	GLuint displacement_map, normal_map, PBO;
+	float last_update;
+	bool simulated;
+	void buildSpectrum();
+	float getSpectrum(float kx, float kz);
+	//One update: advance the spectrum to time, transform it and write the maps.
+	void simulate(float time);
+	void evolve(int row, float time);
+	void transformColumns(float * re, float * im, int first, int count);
+	void transpose(float * data, int tile_row);
+	void pack(int column);
+	void upload();
+
+public:
+	//Must run on the GL thread. The pool runs the transforms.
+	Ocean(ThreadPool * pool, Ocean_settings settings);
+	~Ocean();
+	//Transform again if 1 / update_rate seconds have passed since the last update.
+	void update(float time);
+	Ocean_settings getSettings();
+	GLuint getDisplacementMap();
+	GLuint getNormalMap();
+	float getPatchLength();
+	//How far the surface moves from rest sideways (x) and up or down (y), for culling.
+	glm::vec2 getExtent();
+	//Height and normal of the surface at position, as last updated. The horizontal displacement is ignored.
+	float sampleHeight(glm::vec3 position);
+	glm::vec3 sampleNormal(glm::vec3 position);
+};
+#endif
@@ -1,235 +1,235 @@
-#include "Particle.h"
-#include "Definitions.h"
-#include <time.h>
-
-#define SIZE 40.0f
-#define AREA_SIZE 500
-#define RANDOM_SIZE 500
-#define RANDOM_HEIGHT 0.5f
-#define WATER_HEIGHT (SIZE + 3)
-
-GLuint nr_particles = 1000;
-GLuint lastUsedParticle = 0;
-
-/* Default constructor for a particle with no shape or direction. */
-Particle::Particle(int x_d, int z_d)
-{
-	//Setup particle properties.
-	this->x = x_d * AREA_SIZE + (AREA_SIZE/2);
-	this->z = z_d * AREA_SIZE + (AREA_SIZE/2);
-	this->toWorld = glm::mat4(1.0f);
-	glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->x, 0, this->z));
-	this->toWorld = translate*this->toWorld;
-
-	//Setup the geometry of the particle and generate the VAO.
-	setupGeometry();
-	setupParticle();
-
-	//Setup the particles generator.
-	for (GLuint i = 0; i < nr_particles; ++i) 
-	{
-		this->particles.push_back(Particles_struct());
-	}
-
-}
-
-/* Deconstructor to safely delete when done. */
-Particle::~Particle()
-{
-
-}
-
-/* Setup the shape of the particle. */
-void Particle::setupGeometry()
-{
-	GLfloat vertices_array[] = {
-		// Front vertices
-		-SIZE, -SIZE,  SIZE,
-		SIZE, -SIZE,  SIZE,
-		SIZE,  SIZE,  SIZE,
-		-SIZE,  SIZE,  SIZE,
-		// Back vertices
-		-SIZE, -SIZE, -SIZE,
-		SIZE, -SIZE, -SIZE,
-		SIZE,  SIZE, -SIZE,
-		-SIZE,  SIZE, -SIZE
-	};
-	GLuint indices_array[] = {  // Note that we start from 0!
-		//Right face
-		3, 2, 6,
-		6, 7, 3,
-		//Front face
-		0, 1, 2,
-		2, 3, 0,
-		//Top face
-		1, 5, 6,
-		6, 2, 1,
-		//Back face
-		7, 6, 5,
-		5, 4, 7,
-		//Bottom face
-		4, 0, 3,
-		3, 7, 4,
-		//Left face
-		4, 5, 1,
-		1, 0, 4,
-	};
-	//Front vertices.
-	this->vertices.push_back(glm::vec3(-SIZE, -SIZE, SIZE));
-	this->vertices.push_back(glm::vec3(SIZE, -SIZE, SIZE));
-	this->vertices.push_back(glm::vec3(SIZE, SIZE, SIZE));
-	this->vertices.push_back(glm::vec3(-SIZE, SIZE, SIZE));
-	//Back vertices.
-	this->vertices.push_back(glm::vec3(-SIZE, -SIZE, -SIZE));
-	this->vertices.push_back(glm::vec3(SIZE, -SIZE, -SIZE));
-	this->vertices.push_back(glm::vec3(SIZE, SIZE, -SIZE));
-	this->vertices.push_back(glm::vec3(-SIZE, SIZE, -SIZE));
-	//Faces.
-	for (int i = 35; i >= 0; i--)//35
+#include "Particle.h"
+#include "Definitions.h"
+#include <time.h>
+#include <algorithm>
+
+#define SIZE 40.0f
+#define AREA_SIZE 500
+#define RANDOM_SIZE 500
+#define RANDOM_HEIGHT 0.5f
+#define WATER_HEIGHT (SIZE + 3)
+#define TIME_STEP 0.001f
+//Particles per chunk of an update, a multiple of 8 so every chunk starts on a vector.
+#define CHUNK_SIZE 4096
+
+std::vector<ParticleInstance> Particle::instances;
+
+/* Default constructor for a particle with no shape or direction. */
+Particle::Particle(int x_d, int z_d, int capacity, float spawn_rate)
+{
+	//Setup particle properties.
+	this->x = x_d * AREA_SIZE + (AREA_SIZE/2);
+	this->z = z_d * AREA_SIZE + (AREA_SIZE/2);
+	this->toWorld = glm::mat4(1.0f);
+	glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->x, 0, this->z));
+	this->toWorld = translate*this->toWorld;
+
+	//The geometry is shared, the first emitter uploads it.
+	this->mesh = ParticleMesh::acquire();
+
+	//Setup the particles generator.
+	this->particles = new ParticlePool(capacity);
+	this->spawn_rate = spawn_rate;
+	this->spawn_accumulator = 0.0f;
+	this->limit = capacity;
+	this->frozen = false;
+	this->priority = 1.0f;
+	this->pending = 0;
+	this->simulated = false;
+}
+
+/* Deconstructor to safely delete when done. */
+Particle::~Particle()
+{
+	delete(particles);
+	//The mesh is shared.
+	ParticleMesh::release();
+}
+
+/* Returns if the particle is alive and performs 'animation' on those that are alive. */
+void Particle::update()
+{
+	int chunks = prepare(glfwGetTime());
+	for (int chunk = 0; chunk < chunks; chunk++)
+	{
+		simulate(chunk);
+	}
+	swap();
+}
+
+/* Spawn this update's particles and split the live ones into chunks. Spawning stays on the main thread since rand() isn't safe to share. */
+int Particle::prepare(double time)
+{
+	//Drop whatever is over the limit.
+	particles->shrink(limit);
+	//Bring back spawn_rate particles per update, slowed by the share of the emitter the limit allows and carrying the fraction over. Past the limit the rest are dropped.
+	spawn_accumulator += spawn_rate * limit / particles->capacity;
+	int count = (int)spawn_accumulator;
+	spawn_accumulator -= count;
+	count = std::min(count, limit - particles->alive);
+	int first;
+	int spawned = particles->spawn(count, first);
+	for (int i = first; i < first + spawned; i++)
+	{
+		RespawnParticle(i);
+	}
+	//Every live particle bobs at the same height, so the time is read once.
+	this->bob_height = getBobHeight(time);
+	//Always one chunk, even when nothing is alive, so finish still runs.
+	int chunks = std::max((particles->alive + CHUNK_SIZE - 1) / CHUNK_SIZE, 1);
+	chunk_dead.resize(chunks);
+	pending = chunks;
+	return chunks;
+}
+
+/* Age and move one chunk of the live particles. The chunks touch separate slots, only the last one to finish touches anything shared. */
+void Particle::simulate(int chunk)
+{
+	int begin = chunk * CHUNK_SIZE;
+	int end = std::min(begin + CHUNK_SIZE, particles->alive);
+	chunk_dead[chunk].clear();
+	particles->integrate(begin, end, TIME_STEP, bob_height, chunk_dead[chunk]);
+	if (--pending == 0)
+	{
+		finish();
+	}
+}
+
+/* Remove every particle that died in any chunk, then write the survivors to the back instances. */
+void Particle::finish()
+{
+	dead.clear();
+	for (const std::vector<int> &slots : chunk_dead)
+	{
+		dead.insert(dead.end(), slots.begin(), slots.end());
+	}
+	particles->compact(dead);
+	back.clear();
+	addInstances(back);
+	simulated = true;
+}
+
+/* Show the last finished update, if there's one that isn't showing yet. */
+void Particle::swap()
+{
+	if (!simulated)
+		return;
+	front.swap(back);
+	simulated = false;
+}
+
+/* Return the height the live particles bob at, at time. */
+float Particle::getBobHeight(double time)
+{
+	float num_1 = (float)std::fmod(time, RANDOM_HEIGHT);
+	//Set to variables and update so it oscillates.
+	if (num_1 > (RANDOM_HEIGHT/2)) num_1 = RANDOM_HEIGHT - num_1;
+	return WATER_HEIGHT + 0.01*num_1;
+}
+
+/* Resets the particle to an "origin" state. */
+void Particle::RespawnParticle(int index)
+{
+	//Generate random numbers.
+	GLfloat rand_color = 0.6 + ((rand() % 100) / 100.0f);
+
+	//Set it's life back to 1.
+	particles->life[index] = 1.0f;
+	//Update it's position, the height stays.
+	particles->x[index] = (float)(rand() % RANDOM_SIZE) - (RANDOM_SIZE/2);
+	particles->z[index] = (float)(rand() % RANDOM_SIZE) - (RANDOM_SIZE/2);
+	//Set it's color.
+	particles->red[index] = 0.0f;
+	particles->green[index] = rand_color;
+	particles->blue[index] = 1.0f;
+	particles->alpha[index] = 1.0f;
+	particles->velocity_x[index] = 0.0f;
+	particles->velocity_y[index] = 0.0f;
+	particles->velocity_z[index] = 0.0f;
+}
+
+/* Return the world space box around the particles. They respawn within RANDOM_SIZE / 2 of the center, start at 0 and float at WATER_HEIGHT, each one SIZE wide. */
+AABB Particle::getBounds()
+{
+	AABB box;
+	box.lower = glm::vec3(this->x - RANDOM_SIZE / 2 - SIZE, -SIZE, this->z - RANDOM_SIZE / 2 - SIZE);
+	box.upper = glm::vec3(this->x + RANDOM_SIZE / 2 + SIZE, WATER_HEIGHT + RANDOM_HEIGHT + SIZE, this->z + RANDOM_SIZE / 2 + SIZE);
+	return box;
+}
+
+/* Set how many particles come back per update, fractions build up over several updates. */
+void Particle::setSpawnRate(float spawn_rate)
+{
+	this->spawn_rate = spawn_rate;
+}
+
+/* Set the most particles that may live and whether to stop updating, from the particle budget. */
+void Particle::setBudget(int limit, bool frozen)
+{
+	this->limit = std::max(std::min(limit, particles->capacity), 0);
+	this->frozen = frozen;
+}
+
+/* Return if the budget has frozen this emitter. */
+bool Particle::isFrozen()
+{
+	return this->frozen;
+}
+
+/* Set how this emitter's share of the budget is weighed, 1 by default and 0 freezes it. */
+void Particle::setPriority(float priority)
+{
+	this->priority = priority;
+}
+
+/* Return how this emitter's share of the budget is weighed. */
+float Particle::getPriority()
+{
+	return this->priority;
+}
+
+/* Return the most particles this emitter can hold. */
+int Particle::getCapacity()
+{
+	return particles->capacity;
+}
+
+/* Return how many particles are alive. */
+int Particle::getAlive()
+{
+	return particles->alive;
+}
+
+/* Append the live particles, moved from the emitter's space to world space. */
+void Particle::addInstances(std::vector<ParticleInstance> &instances)
+{
+	glm::vec3 center = glm::vec3(this->toWorld[3]);
+	for (int i = 0; i < particles->alive; i++)
 	{
-		this->indices.push_back(indices_array[i]);
-	}
-}
-
-/* Setup the particle. */
-void Particle::setupParticle()
-{
-	//Create buffers/arrays.
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-	glGenBuffers(1, &EBO);
-
-	//Bind the Vertex Array Object first, then bind and set vertex buffer(s) and attribute pointer(s).
-	glBindVertexArray(VAO); //Bind vertex array object.
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO); //Bind vertex buffer.
-	glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * 3 * sizeof(GLfloat), &this->vertices[0], GL_STATIC_DRAW);//Set vertex buffer to vertices.
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO); //Bind the EBO for the indices (faces). 
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(int), &this->indices[0], GL_STATIC_DRAW);
-
-	//Vertex Positions.
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0,// This first parameter x should be the same as the number passed into the line "layout (location = x)" in the vertex shader. In this case, it's 0. Valid values are 0 to GL_MAX_UNIFORM_LOCATIONS.
-		3, // This second line tells us how any components there are per vertex. In this case, it's 3 (we have an x, y, and z component)
-		GL_FLOAT, // What type these components are
-		GL_FALSE, // GL_TRUE means the values should be normalized. GL_FALSE means they shouldn't
-		3 * sizeof(GLfloat), // Offset between consecutive vertex attributes. Since each of our vertices have 3 floats, they should have the size of 3 floats in between
-		(GLvoid*)0); // Offset of the first vertex's component. In our case it's 0 since we don't pad the vertices array with anything.
-
-	glBindBuffer(GL_ARRAY_BUFFER, 0); //Note that this is allowed, the call to glVertexAttribPointer registered VBO as the currently bound vertex buffer object so afterwards we can safely unbind.
-
-	glBindVertexArray(0); //Unbind VAO (it's always a good thing to unbind any buffer/array to prevent strange bugs), remember: do NOT unbind the EBO, keep it bound to this VAO.
-}
-
-/* Returns if the particle is alive and performs 'animation' on those that are alive. */
-void Particle::update()
-{
-	GLuint nr_new_particles = 1;
-	float dt = 0.001;
-	//Add new particles when dead to constantly generate more particles.
-	for (GLuint i = 0; i < nr_new_particles; ++i)
-	{
-		int unusedParticle = FirstUnusedParticle();
-		RespawnParticle(particles[unusedParticle]);
-	}
-	//Update all particles to determine it's new life.
-	for (GLuint i = 0; i < nr_particles; ++i)
-	{
-		Particles_struct &cur_particle = particles[i];
-		cur_particle.Life -= dt;//Reduce it's life.
-		//If the particle is alive, we update it.
-		if (cur_particle.Life > 0.0f)
-		{
-			animate(cur_particle);
-		}
-	}
-}
-
-/* Animate the particle. */
-void Particle::animate(Particles_struct &particle)
-{
-	double timer = glfwGetTime();
-	float num_1 = (float)std::fmod(timer, RANDOM_HEIGHT);
-	//Set to variables and update so it oscillates.
-	if (num_1 > (RANDOM_HEIGHT/2)) num_1 = RANDOM_HEIGHT - num_1;
-	particle.Position.y = WATER_HEIGHT + 0.01*num_1;
-}
-
-/* Find the most recently unused particle to restart. */
-GLuint Particle::FirstUnusedParticle()
-{
-	//Search from last used particle, this will usually return almost instantly
-	for (GLuint i = lastUsedParticle; i < nr_particles; ++i) {
-		if (particles[i].Life <= 0.0f) {
-			lastUsedParticle = i;
-			return i;
-		}
-	}
-	//Otherwise, do a linear search
-	for (GLuint i = 0; i < lastUsedParticle; ++i) {
-		if (particles[i].Life <= 0.0f) {
-			lastUsedParticle = i;
-			return i;
-		}
-	}
-	//Override first particle if all others are alive
-	lastUsedParticle = 0;
-	return 0;
-}
-
-/* Resets the particle to an "origin" state. */
-void Particle::RespawnParticle(Particles_struct &particle)
-{
-	//Generate random numbers.
-	GLfloat rand_color = 0.6 + ((rand() % 100) / 100.0f);
-
-	//Set it's life back to 1.
-	particle.Life = 1.0f;
-	//Update it's position.
-	float dirX = (float)(rand() % RANDOM_SIZE) - (RANDOM_SIZE/2);
-	float dirY = particle.Position.y;
-	float dirZ = (float)(rand() % RANDOM_SIZE) - (RANDOM_SIZE/2);
-	particle.Position = glm::vec3(dirX, dirY, dirZ);
-	//Set it's color.
-	particle.Color = glm::vec4(0.0f, rand_color, 1.0f, 1.0f);
-	particle.Velocity = glm::vec3(0.0f);
-}
-
-/* Draw the Particle. */
+		ParticleInstance instance;
+		instance.offset = glm::vec3(particles->x[i], particles->y[i], particles->z[i]) + center;
+		instance.color = glm::vec4(particles->red[i], particles->green[i], particles->blue[i], particles->alpha[i]);
+		instances.push_back(instance);
+	}
+}
+
+/* Draw the Particle, as a single emitter. */
 void Particle::draw(GLuint shaderProgram)
-{
-	glm::mat4 MVP = Window::P * Window::V * this->toWorld;
-	glm::mat4 model = this->toWorld;//We don't really need this, but we'll pass it through just in case.
-	glm::mat4 view = glm::mat4(glm::mat3(Window::V));//Remove translation from the view matrix.
-	glm::mat4 projection = Window::P;
-	//Set MVP(Total calculated, easier to multiply in the shader) for the shader.
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "MVP"), 1, GL_FALSE, &MVP[0][0]);
-	//Set individual components for shader calculations (Model, View, Projection).
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, &model[0][0]);
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, &view[0][0]);
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
-	//Update viewPos.
-	glUniform3f(glGetUniformLocation(shaderProgram, "viewPos"), Window::camera_pos.x, Window::camera_pos.y, Window::camera_pos.z);
-	//Draw.
-	glBindVertexArray(VAO);//Bind the vertex.
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-	for (Particles_struct particle : this->particles)
-	{
-		if (particle.Life > 0.0f)
-		{
-			glBindVertexArray(VAO);//Bind the vertex.
-			//Perform any updates per particle here.
-			glUniform3f(glGetUniformLocation(shaderProgram, "offset"), particle.Position.x, particle.Position.y, particle.Position.z);
-			glUniform4f(glGetUniformLocation(shaderProgram, "p_color"), particle.Color.x, particle.Color.y, particle.Color.z, particle.Color.w);
-			//Draw the element.
-			if (Window::toon_shading)
-			{
-				glDrawElements(GL_TRIANGLES, (GLsizei)6, GL_UNSIGNED_INT, 0);
-				glBindVertexArray(0);
-			}
-		}
-	}
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glBindVertexArray(0);//Unbind vertex.
-}
+{
+	std::vector<Particle*> emitters(1, this);
+	Particle::draw(shaderProgram, emitters);
+}
+
+/* Draw every emitter's particles as of its last finished update, in one instanced call. */
+void Particle::draw(GLuint shaderProgram, const std::vector<Particle*> &emitters)
+{
+	//Particles only show with toon shading.
+	if (emitters.empty() || !Window::toon_shading)
+		return;
+	instances.clear();
+	for (Particle * emitter : emitters)
+	{
+		instances.insert(instances.end(), emitter->front.begin(), emitter->front.end());
+	}
+	emitters[0]->mesh->draw(shaderProgram, instances);
+}
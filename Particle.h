@@ -1,44 +1,80 @@
-#pragma once
-#ifndef PARTICLE_H
-#define PARTICLE_H
-
-#include "Window.h"
-#include "Definitions.h"
-#include "OBJObject.h"
-
-class Particle
-{
-private:
-
-	std::vector<Particles_struct> particles;
-	std::vector<glm::vec3> vertices;//v
-	std::vector<unsigned int> indices;//f
-
-	float x, z;
-
-	GLuint VAO, VBO, EBO;
-
-	glm::mat4 toWorld;
-	float gravity;
-	OBJObject * toFollow;
-
-	void setupGeometry();
-	void setupParticle();
-
-	GLuint FirstUnusedParticle();
-	void RespawnParticle(Particles_struct &particle);
-	void animate(Particles_struct &particle);
-public:
-	/* Object constructor and setups */
-	Particle(int x_d, int z_d);
-	Particle(OBJObject * follow);
-	~Particle();
-
-	void update();
-	void draw(GLuint shaderProgram);
-
-	void increaseGravity();
-	void decreaseGravity();
-};
-
+#pragma once
+#ifndef PARTICLE_H
+#define PARTICLE_H
+
+#include "Window.h"
+#include "Definitions.h"
+#include "OBJObject.h"
+#include "ParticleMesh.h"
+#include "ParticlePool.h"
+#include <atomic>
+
+class Particle
+{
+private:
+
+	ParticlePool * particles;
+	//Particles brought back per update, the fraction is carried in the accumulator.
+	float spawn_rate;
+	float spawn_accumulator;
+	//Set every frame by the particle budget: at most limit live, spawning slowed to match, and nothing updates or draws while frozen. The priority weighs this emitter's share.
+	int limit;
+	bool frozen;
+	float priority;
+
+	float x, z;
+
+	//The shape is shared by every emitter, each live particle is one instance of it.
+	ParticleMesh * mesh;
+	//Scratch space for the instances of every emitter drawn together.
+	static std::vector<ParticleInstance> instances;
+	//Append this emitter's live particles, in world space.
+	void addInstances(std::vector<ParticleInstance> &instances);
+	//Double buffered instances: the draw reads front, the last finished update, while the workers fill back.
+	std::vector<ParticleInstance> front, back;
+	//The update in flight: the height its particles bob at, the slots each chunk found dead, all of them in order, and how many chunks are still running.
+	float bob_height;
+	std::vector<std::vector<int>> chunk_dead;
+	std::vector<int> dead;
+	std::atomic<int> pending;
+	//Whether back holds an update that swap hasn't shown yet.
+	bool simulated;
+	//Remove the dead and fill back, run by whichever chunk finishes last.
+	void finish();
+
+	glm::mat4 toWorld;
+	float gravity;
+	OBJObject * toFollow;
+
+	void RespawnParticle(int index);
+	float getBobHeight(double time);
+public:
+	/* Object constructor and setups */
+	Particle(int x_d, int z_d, int capacity = 1000, float spawn_rate = 1.0f);
+	Particle(OBJObject * follow);
+	~Particle();
+
+	//Update on this thread and show the result straight away.
+	void update();
+	//The update split up for the workers: prepare spawns on the main thread and returns how many chunks there are, simulate can then run every chunk on any threads at once, and swap shows the result once all of them are done.
+	int prepare(double time);
+	void simulate(int chunk);
+	void swap();
+	void draw(GLuint shaderProgram);
+	//Draw every emitter's live particles with one instanced call.
+	static void draw(GLuint shaderProgram, const std::vector<Particle*> &emitters);
+	//World space box around every place a particle can be, for culling.
+	AABB getBounds();
+
+	void setSpawnRate(float spawn_rate);
+	void setBudget(int limit, bool frozen);
+	bool isFrozen();
+	void setPriority(float priority);
+	float getPriority();
+	int getCapacity();
+	int getAlive();
+	void increaseGravity();
+	void decreaseGravity();
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "ParticleBudget.h"
+
+/* Constructor with the budget and how it's shared. */
+ParticleBudget::ParticleBudget(Particle_budget_settings settings)
+{
+	this->settings = settings;
+}
+
+/* Weigh every emitter, then share the budget out by weight. */
+int ParticleBudget::update(const std::vector<Particle*> &emitters, glm::vec3 camera, Frustum &frustum)
+{
+	int count = (int)emitters.size();
+	weights.assign(count, 0.0f);
+	limits.assign(count, 0);
+	settled.assign(count, true);
+	//Only emitters close enough to update get a weight. A priority of 0 freezes an emitter too.
+	for (int i = 0; i < count; i++)
+	{
+		if (emitters[i] == nullptr)
+			continue;
+		AABB box = emitters[i]->getBounds();
+		float distance = glm::length(camera - glm::clamp(camera, box.lower, box.upper));
+		if (distance > settings.freeze_distance)
+			continue;
+		float scaled = distance / settings.falloff;
+		float weight = emitters[i]->getPriority() / (1.0f + scaled * scaled);
+		if (!frustum.isVisible(box))
+			weight *= settings.hidden_weight;
+		if (weight <= 0.0f)
+			continue;
+		weights[i] = weight;
+		settled[i] = false;
+	}
+	//An emitter whose share is more than it holds is filled and settled, which leaves more for the rest, so go round until every share fits.
+	int remaining = settings.budget;
+	bool filled = true;
+	while (filled)
+	{
+		filled = false;
+		float total = 0.0f;
+		for (int i = 0; i < count; i++)
+		{
+			if (!settled[i])
+				total += weights[i];
+		}
+		if (total <= 0.0f)
+			break;
+		int given = 0;
+		for (int i = 0; i < count; i++)
+		{
+			if (settled[i])
+				continue;
+			float share = remaining * (weights[i] / total);
+			int capacity = emitters[i]->getCapacity();
+			if (share >= capacity)
+			{
+				limits[i] = capacity;
+				settled[i] = true;
+				given += capacity;
+				filled = true;
+			}
+			else
+			{
+				limits[i] = (int)share;
+			}
+		}
+		remaining -= given;
+	}
+	//Hand the limits out, freezing every emitter without a weight.
+	int handed_out = 0;
+	for (int i = 0; i < count; i++)
+	{
+		if (emitters[i] == nullptr)
+			continue;
+		emitters[i]->setBudget(limits[i], weights[i] <= 0.0f);
+		handed_out += limits[i];
+	}
+	return handed_out;
+}
+
+/* Change the budget or how it's shared, from the next update on. */
+void ParticleBudget::setSettings(Particle_budget_settings settings)
+{
+	this->settings = settings;
+}
+
+/* Return the budget and how it's shared. */
+Particle_budget_settings ParticleBudget::getSettings()
+{
+	return this->settings;
+}
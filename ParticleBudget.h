@@ -0,0 +1,27 @@
+#pragma once
+#ifndef PARTICLEBUDGET_H
+#define PARTICLEBUDGET_H
+
+#include "Window.h"
+#include "Definitions.h"
+#include "Particle.h"
+#include "Frustum.h"
+
+/* Shares one budget of live particles between every emitter, every frame, so the cost stays the same however many tiles there are. An emitter's weight is its priority, falling off with distance from the camera and cut while it's out of view, and it gets the budget times its part of the total weight but never more than it holds. What a full emitter can't use goes to the rest. Emitters past the freeze distance get nothing and stop updating, keeping their particles for when the camera comes back. */
+class ParticleBudget
+{
+private:
+	Particle_budget_settings settings;
+	//Scratch space: each emitter's weight, its limit and whether the limit is final.
+	std::vector<float> weights;
+	std::vector<int> limits;
+	std::vector<bool> settled;
+
+public:
+	ParticleBudget(Particle_budget_settings settings = Particle_budget_settings());
+	//Set every emitter's limit for this frame, skipping nullptr. Returns how many particles were handed out.
+	int update(const std::vector<Particle*> &emitters, glm::vec3 camera, Frustum &frustum);
+	void setSettings(Particle_budget_settings settings);
+	Particle_budget_settings getSettings();
+};
+#endif
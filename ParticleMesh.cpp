@@ -0,0 +1,140 @@
+#include "ParticleMesh.h"
+#include <cstddef>
+
+#define SIZE 40.0f
+//Only the first face of the cube is drawn.
+#define INDICES_DRAWN 6
+
+ParticleMesh * ParticleMesh::shared = nullptr;
+int ParticleMesh::references = 0;
+
+/* Setup the shape of the particle and the instance buffer. */
+ParticleMesh::ParticleMesh()
+{
+	GLuint indices_array[] = {  // Note that we start from 0!
+		//Right face
+		3, 2, 6,
+		6, 7, 3,
+		//Front face
+		0, 1, 2,
+		2, 3, 0,
+		//Top face
+		1, 5, 6,
+		6, 2, 1,
+		//Back face
+		7, 6, 5,
+		5, 4, 7,
+		//Bottom face
+		4, 0, 3,
+		3, 7, 4,
+		//Left face
+		4, 5, 1,
+		1, 0, 4,
+	};
+	std::vector<glm::vec3> vertices;
+	std::vector<unsigned int> indices;
+	//Front vertices.
+	vertices.push_back(glm::vec3(-SIZE, -SIZE, SIZE));
+	vertices.push_back(glm::vec3(SIZE, -SIZE, SIZE));
+	vertices.push_back(glm::vec3(SIZE, SIZE, SIZE));
+	vertices.push_back(glm::vec3(-SIZE, SIZE, SIZE));
+	//Back vertices.
+	vertices.push_back(glm::vec3(-SIZE, -SIZE, -SIZE));
+	vertices.push_back(glm::vec3(SIZE, -SIZE, -SIZE));
+	vertices.push_back(glm::vec3(SIZE, SIZE, -SIZE));
+	vertices.push_back(glm::vec3(-SIZE, SIZE, -SIZE));
+	//Faces.
+	for (int i = 35; i >= 0; i--)
+	{
+		indices.push_back(indices_array[i]);
+	}
+	this->instance_capacity = 0;
+	//Create buffers/arrays.
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+	glGenBuffers(1, &INSTANCES);
+	glBindVertexArray(VAO);
+	//Vertex Positions.
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), &vertices[0], GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
+	glEnableVertexAttribArray(0);
+	//One offset and color per instance.
+	glBindBuffer(GL_ARRAY_BUFFER, INSTANCES);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (GLvoid*)offsetof(ParticleInstance, offset));
+	glEnableVertexAttribArray(1);
+	glVertexAttribDivisor(1, 1);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (GLvoid*)offsetof(ParticleInstance, color));
+	glEnableVertexAttribArray(2);
+	glVertexAttribDivisor(2, 1);
+	//Faces.
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+/* Deconstructor to safely delete when finished. */
+ParticleMesh::~ParticleMesh()
+{
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &EBO);
+	glDeleteBuffers(1, &INSTANCES);
+}
+
+/* Return the shared mesh and add a reference to it. */
+ParticleMesh * ParticleMesh::acquire()
+{
+	if (shared == nullptr)
+	{
+		shared = new ParticleMesh();
+	}
+	references++;
+	return shared;
+}
+
+/* Drop a reference, the mesh is deleted with the last one. */
+void ParticleMesh::release()
+{
+	references--;
+	if (references == 0)
+	{
+		delete(shared);
+		shared = nullptr;
+	}
+}
+
+/* Stream the instances and draw them all at once. */
+void ParticleMesh::draw(GLuint shaderProgram, const std::vector<ParticleInstance> &instances)
+{
+	if (instances.empty())
+		return;
+	//The instances are already in world space, so the model matrix is the identity.
+	glm::mat4 MVP = Window::P * Window::V;
+	glm::mat4 model = glm::mat4(1.0f);
+	glm::mat4 view = glm::mat4(glm::mat3(Window::V));//Remove translation from the view matrix.
+	glm::mat4 projection = Window::P;
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "MVP"), 1, GL_FALSE, &MVP[0][0]);
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, &model[0][0]);
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, &view[0][0]);
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
+	//Update viewPos.
+	glUniform3f(glGetUniformLocation(shaderProgram, "viewPos"), Window::camera_pos.x, Window::camera_pos.y, Window::camera_pos.z);
+	//Orphan last frame's instances so the driver doesn't wait on them, growing the buffer when there are more than ever before.
+	glBindBuffer(GL_ARRAY_BUFFER, INSTANCES);
+	if ((GLsizei)instances.size() > instance_capacity)
+	{
+		instance_capacity = (GLsizei)instances.size();
+	}
+	glBufferData(GL_ARRAY_BUFFER, instance_capacity * sizeof(ParticleInstance), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(ParticleInstance), &instances[0]);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	//Draw.
+	glBindVertexArray(VAO);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+	glDrawElementsInstanced(GL_TRIANGLES, INDICES_DRAWN, GL_UNSIGNED_INT, 0, (GLsizei)instances.size());
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glBindVertexArray(0);
+}
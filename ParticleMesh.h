@@ -0,0 +1,28 @@
+#pragma once
+#ifndef PARTICLEMESH_H
+#define PARTICLEMESH_H
+
+#include "Window.h"
+#include "Definitions.h"
+
+/* The shape every particle is drawn with. It's the same for every emitter, so it's uploaded once and each live particle is an instance of it moved and coloured by its ParticleInstance. */
+class ParticleMesh
+{
+private:
+	//One shared instance, deleted when the last emitter releases it.
+	static ParticleMesh * shared;
+	static int references;
+	ParticleMesh();
+	~ParticleMesh();
+	//GLSL properties. INSTANCES is refilled with the live particles every draw.
+	GLuint VAO, VBO, EBO, INSTANCES;
+	GLsizei instance_capacity;
+
+public:
+	//Get the shared mesh, creating it on first use. Must run on the GL thread.
+	static ParticleMesh * acquire();
+	static void release();
+	//Draw every instance in a single call.
+	void draw(GLuint shaderProgram, const std::vector<ParticleInstance> &instances);
+};
+#endif
@@ -0,0 +1,177 @@
+#include "ParticlePool.h"
+#include <cstring>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define POOL_AVX
+#define POOL_SSE
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define POOL_SSE
+#endif
+
+//Arrays start on a 32 byte boundary and hold a multiple of 8 floats, so the AVX loop needs no scalar tail.
+#define ALIGNMENT 32
+#define PADDING 8
+#define ARRAYS 11
+
+/* Allocate every array in one aligned block. The padding past capacity is never live. */
+ParticlePool::ParticlePool(int capacity)
+{
+	this->capacity = capacity;
+	this->alive = capacity;
+	this->dead.reserve(capacity);
+	this->stride = (capacity + PADDING - 1) / PADDING * PADDING;
+	size_t count = (size_t)ARRAYS * stride;
+#ifdef POOL_SSE
+	this->block = (float*)_mm_malloc(count * sizeof(float), ALIGNMENT);
+#else
+	this->block = new float[count];
+#endif
+	memset(block, 0, count * sizeof(float));
+	float ** arrays[ARRAYS] = { &x, &y, &z, &velocity_x, &velocity_y, &velocity_z, &red, &green, &blue, &alpha, &life };
+	for (int i = 0; i < ARRAYS; i++)
+	{
+		*arrays[i] = block + (size_t)i * stride;
+	}
+	for (int i = 0; i < capacity; i++)
+	{
+		blue[i] = 1.0f;
+		alpha[i] = 1.0f;
+		life[i] = 1.0f;
+	}
+}
+
+/* Deconstructor to safely delete when finished. */
+ParticlePool::~ParticlePool()
+{
+#ifdef POOL_SSE
+	_mm_free(block);
+#else
+	delete[] block;
+#endif
+}
+
+/* Return the next count dead slots, or as many as are left. */
+int ParticlePool::spawn(int count, int &first)
+{
+	first = alive;
+	if (count > capacity - alive)
+	{
+		count = capacity - alive;
+	}
+	if (count < 0)
+	{
+		count = 0;
+	}
+	alive += count;
+	return count;
+}
+
+/* Drop the live particles past count, they're at the end so nothing moves. */
+void ParticlePool::shrink(int count)
+{
+	if (count < 0)
+	{
+		count = 0;
+	}
+	if (count < alive)
+	{
+		alive = count;
+	}
+}
+
+/* Copy every component of one slot over another. */
+void ParticlePool::move(int from, int to)
+{
+	for (float * array = block; array < block + (size_t)ARRAYS * stride; array += stride)
+	{
+		array[to] = array[from];
+	}
+}
+
+/* Update every live particle on this thread. */
+void ParticlePool::update(float dt, float height)
+{
+	dead.clear();
+	integrate(0, alive, dt, height, dead);
+	compact(dead);
+}
+
+/* The whole update in one pass over [begin, end): life -= dt, position += velocity * dt, and y = height wherever life is still above 0. The loop runs on to the end of the last vector. That only happens when end is alive, so those slots are dead and changing them does no harm. */
+void ParticlePool::integrate(int begin, int end, float dt, float height, std::vector<int> &dead)
+{
+	int i = begin;
+#if defined(POOL_AVX)
+	__m256 step = _mm256_set1_ps(dt);
+	__m256 bob = _mm256_set1_ps(height);
+	__m256 zero = _mm256_setzero_ps();
+	int last = (end + 7) / 8 * 8;
+	for (; i < last; i += 8)
+	{
+		__m256 remaining = _mm256_sub_ps(_mm256_load_ps(life + i), step);
+		_mm256_store_ps(life + i, remaining);
+		_mm256_store_ps(x + i, _mm256_add_ps(_mm256_load_ps(x + i), _mm256_mul_ps(_mm256_load_ps(velocity_x + i), step)));
+		_mm256_store_ps(z + i, _mm256_add_ps(_mm256_load_ps(z + i), _mm256_mul_ps(_mm256_load_ps(velocity_z + i), step)));
+		__m256 moved = _mm256_add_ps(_mm256_load_ps(y + i), _mm256_mul_ps(_mm256_load_ps(velocity_y + i), step));
+		__m256 living = _mm256_cmp_ps(remaining, zero, _CMP_GT_OQ);
+		_mm256_store_ps(y + i, _mm256_blendv_ps(moved, bob, living));
+		int died = ~_mm256_movemask_ps(living) & 0xFF;
+		for (int lane = 0; died != 0; lane++, died >>= 1)
+		{
+			if ((died & 1) && i + lane < end)
+				dead.push_back(i + lane);
+		}
+	}
+#elif defined(POOL_SSE)
+	__m128 step = _mm_set1_ps(dt);
+	__m128 bob = _mm_set1_ps(height);
+	__m128 zero = _mm_setzero_ps();
+	int last = (end + 3) / 4 * 4;
+	for (; i < last; i += 4)
+	{
+		__m128 remaining = _mm_sub_ps(_mm_load_ps(life + i), step);
+		_mm_store_ps(life + i, remaining);
+		_mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(_mm_load_ps(velocity_x + i), step)));
+		_mm_store_ps(z + i, _mm_add_ps(_mm_load_ps(z + i), _mm_mul_ps(_mm_load_ps(velocity_z + i), step)));
+		__m128 moved = _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(_mm_load_ps(velocity_y + i), step));
+		__m128 living = _mm_cmpgt_ps(remaining, zero);
+		_mm_store_ps(y + i, _mm_or_ps(_mm_and_ps(living, bob), _mm_andnot_ps(living, moved)));
+		int died = ~_mm_movemask_ps(living) & 0xF;
+		for (int lane = 0; died != 0; lane++, died >>= 1)
+		{
+			if ((died & 1) && i + lane < end)
+				dead.push_back(i + lane);
+		}
+	}
+#endif
+	for (; i < end; i++)
+	{
+		life[i] -= dt;
+		x[i] += velocity_x[i] * dt;
+		y[i] += velocity_y[i] * dt;
+		z[i] += velocity_z[i] * dt;
+		if (life[i] > 0.0f)
+		{
+			y[i] = height;
+		}
+		else
+		{
+			dead.push_back(i);
+		}
+	}
+}
+
+/* Fill every dead slot with the last live particle. */
+void ParticlePool::compact(const std::vector<int> &dead)
+{
+	//Last first, so the live particle moved into each hole comes from past every hole still to fill.
+	for (int d = (int)dead.size() - 1; d >= 0; d--)
+	{
+		alive--;
+		if (dead[d] != alive)
+		{
+			move(alive, dead[d]);
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef PARTICLEPOOL_H
+#define PARTICLEPOOL_H
+
+#include "Window.h"
+
+/* Particles stored as one array per component so the update can work on four (SSE) or eight (AVX) particles at a time. Every array is aligned and padded to a whole number of vectors.
+The live particles are always [0, alive) and the dead ones [alive, capacity): spawning hands out the first dead slots and a particle that dies is replaced by the last live one, so nothing ever searches and the dead are never touched. */
+class ParticlePool
+{
+private:
+	//One allocation that every array points into.
+	float * block;
+	int stride;
+	//Slots that died during the last update, in increasing order.
+	std::vector<int> dead;
+	//Copy every component of one slot over another.
+	void move(int from, int to);
+	ParticlePool(const ParticlePool&) = delete;
+	ParticlePool& operator=(const ParticlePool&) = delete;
+
+public:
+	//Starts with every particle alive at the origin, blue and at rest.
+	ParticlePool(int capacity);
+	~ParticlePool();
+	int capacity;
+	int alive;
+	float * x;
+	float * y;
+	float * z;
+	float * velocity_x;
+	float * velocity_y;
+	float * velocity_z;
+	float * red;
+	float * green;
+	float * blue;
+	float * alpha;
+	float * life;
+	//Bring up to count dead slots to life, they are [first, first + the number returned). Fewer are returned when the pool is full.
+	int spawn(int count, int &first);
+	//Kill every live particle from count on.
+	void shrink(int count);
+	//Age every live particle by dt and move it by its velocity, then the ones still alive bob at height and the rest are removed.
+	void update(float dt, float height);
+	//The two halves of update, so it can be split across threads. integrate does [begin, end) and adds the slots that died to dead. begin, and end unless it's alive, must be multiples of 8, then ranges that don't overlap can run at once. compact then removes every slot in dead, which must be in increasing order.
+	void integrate(int begin, int end, float dt, float height, std::vector<int> &dead);
+	void compact(const std::vector<int> &dead);
+};
+#endif
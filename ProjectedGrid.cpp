@@ -0,0 +1,160 @@
+#include "ProjectedGrid.h"
+#include "WaterMesh.h"
+#include <algorithm>
+#include <cfloat>
+
+//Water surface height and how far the ripples move it, as in Water.cpp.
+#define HEIGHT 3.0f
+#define RIPPLE_HEIGHT 1.0f
+//How far past the screen's edges the grid reaches, so waves pushed sideways don't open gaps at the edges.
+#define SCREEN_PADDING 0.1f
+
+/* Setup the grid and its triangles once, only the projector changes from frame to frame. */
+ProjectedGrid::ProjectedGrid(int columns, int rows)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<unsigned int> indices;
+	vertices.reserve(columns * rows);
+	indices.reserve((columns - 1) * (rows - 1) * 6);
+	for (int r = 0; r < rows; r++)
+	{
+		for (int c = 0; c < columns; c++)
+		{
+			vertices.push_back(glm::vec3((float)c / (columns - 1), (float)r / (rows - 1), 0.0f));
+		}
+	}
+	for (int r = 0; r < rows - 1; r++)
+	{
+		for (int c = 0; c < columns - 1; c++)
+		{
+			unsigned int topLeft = r * columns + c;
+			unsigned int topRight = topLeft + 1;
+			unsigned int bottomLeft = topLeft + columns;
+			unsigned int bottomRight = bottomLeft + 1;
+			//Push back to indices.
+			indices.push_back(topLeft);
+			indices.push_back(bottomLeft);
+			indices.push_back(topRight);
+			indices.push_back(topRight);
+			indices.push_back(bottomLeft);
+			indices.push_back(bottomRight);
+		}
+	}
+	this->index_count = (GLsizei)indices.size();
+	//Create buffers/arrays
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), &vertices[0], GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
+	glEnableVertexAttribArray(0);
+	//The normal and the tile offset are constant attributes, the tiles come from the projected position instead.
+	glDisableVertexAttribArray(1);
+	glDisableVertexAttribArray(2);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+/* Deconstructor to safely delete when finished. */
+ProjectedGrid::~ProjectedGrid()
+{
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &EBO);
+}
+
+/* Find where the slab of water between height - margin and height + margin meets the view frustum, flatten those points onto the plane and take their screen rectangle. The projector maps the grid onto that rectangle and then back out to world space. */
+bool ProjectedGrid::getProjector(glm::mat4 PV, glm::vec3 camera, float height, float margin, glm::mat4 &projector)
+{
+	glm::mat4 inverse = glm::inverse(PV);
+	float upper = height + margin;
+	float lower = height - margin;
+	glm::vec2 low(-1.0f);
+	glm::vec2 high(1.0f);
+	//From inside the slab the water can be anywhere on screen.
+	if (camera.y > upper || camera.y < lower)
+	{
+		//Corners of the frustum, bit 0 picks x, bit 1 y and bit 2 near or far.
+		glm::vec3 corners[8];
+		for (int i = 0; i < 8; i++)
+		{
+			glm::vec4 corner = inverse * glm::vec4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+			corners[i] = glm::vec3(corner) / corner.w;
+		}
+		//Corners inside the slab and where the frustum's edges cross its two planes.
+		std::vector<glm::vec3> points;
+		for (int i = 0; i < 8; i++)
+		{
+			if (corners[i].y >= lower && corners[i].y <= upper)
+				points.push_back(corners[i]);
+			for (int bit = 1; bit < 8; bit <<= 1)
+			{
+				if (i & bit)
+					continue;
+				glm::vec3 a = corners[i];
+				glm::vec3 b = corners[i | bit];
+				float planes[2] = { lower, upper };
+				for (int p = 0; p < 2; p++)
+				{
+					if ((a.y - planes[p]) * (b.y - planes[p]) < 0.0f)
+						points.push_back(a + (b - a) * ((planes[p] - a.y) / (b.y - a.y)));
+				}
+			}
+		}
+		if (points.empty())
+			return false;
+		low = glm::vec2(FLT_MAX);
+		high = glm::vec2(-FLT_MAX);
+		for (glm::vec3 &point : points)
+		{
+			glm::vec4 clip = PV * glm::vec4(point.x, height, point.z, 1.0f);
+			//Flattened behind the camera, fall back to the whole screen.
+			if (clip.w <= 0.0f)
+			{
+				low = glm::vec2(-1.0f);
+				high = glm::vec2(1.0f);
+				break;
+			}
+			glm::vec2 screen = glm::vec2(clip) / clip.w;
+			low = glm::min(low, screen);
+			high = glm::max(high, screen);
+		}
+	}
+	low = glm::max(low - SCREEN_PADDING, glm::vec2(-1.0f - SCREEN_PADDING));
+	high = glm::min(high + SCREEN_PADDING, glm::vec2(1.0f + SCREEN_PADDING));
+	if (low.x >= high.x || low.y >= high.y)
+		return false;
+	//Grid (u, v) to the rectangle, keeping z and w.
+	glm::mat4 range(1.0f);
+	range[0][0] = high.x - low.x;
+	range[1][1] = high.y - low.y;
+	range[3][0] = low.x;
+	range[3][1] = low.y;
+	projector = inverse * range;
+	return true;
+}
+
+/* Fit the grid to the screen and draw it in one call. */
+bool ProjectedGrid::draw(GLuint shaderProgram, float time, int draw_mode, GLuint skyTexture, Ocean * ocean)
+{
+	glm::mat4 projector;
+	float margin = (ocean != nullptr) ? ocean->getExtent().y : RIPPLE_HEIGHT;
+	if (!getProjector(Window::P * Window::V, Window::camera_pos, HEIGHT, margin, projector))
+		return false;
+	WaterMesh::bind(shaderProgram, time, draw_mode, skyTexture, ocean);
+	glUniform1i(glGetUniformLocation(shaderProgram, "projected"), true);
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projector"), 1, GL_FALSE, &projector[0][0]);
+	glUniform1f(glGetUniformLocation(shaderProgram, "water_height"), HEIGHT);
+	glBindVertexArray(VAO);
+	glVertexAttrib3f(1, 0.0f, 1.0f, 0.0f);
+	glVertexAttrib3f(2, 0.0f, 0.0f, 0.0f);
+	glDrawElements(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, 0);
+	glBindVertexArray(0);
+	//Set it back to fill.
+	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef PROJECTEDGRID_H
+#define PROJECTEDGRID_H
+
+#include "Window.h"
+#include "Ocean.h"
+
+/* Water drawn as one grid laid out in screen space and projected onto the sea plane, so the vertices are spread evenly over the screen from the camera out to the horizon. Every frame the grid is fitted to the part of the screen where the water (and its waves) can show, then water.vert drops each vertex back onto the plane. */
+class ProjectedGrid
+{
+private:
+	//GLSL properties. The grid is (u, v) in [0, 1].
+	GLuint VAO, VBO, EBO;
+	GLsizei index_count;
+	//Map the grid onto the screen rectangle that can show the plane y = height with waves margin above and below, then back to world space. False if none of it is on screen.
+	bool getProjector(glm::mat4 PV, glm::vec3 camera, float height, float margin, glm::mat4 &projector);
+
+public:
+	//Must run on the GL thread.
+	ProjectedGrid(int columns, int rows);
+	~ProjectedGrid();
+	//Draw the water, showing ocean's waves if it isn't nullptr and the ripples at time otherwise. Returns false if no water was in view.
+	bool draw(GLuint shaderProgram, float time, int draw_mode, GLuint skyTexture, Ocean * ocean);
+};
+#endif
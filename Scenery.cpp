@@ -1,191 +1,938 @@
-#include "Scenery.h"
-#include <string>
-#include <string>
-#include <sstream> 
-
-#define TERRAIN_SIZE 500.0f
-
-/* Constructor to create a terrain map with a specified width and height. */
-Scenery::Scenery(int width, int height, GLuint skybox_texture)
-{
-	//Setup the width, height, and boundaries of the scene.
-	this->width = width;
-	this->height = height;
-	this->boundaries.x = width * TERRAIN_SIZE;
-	this->boundaries.y = height * TERRAIN_SIZE;
-	this->skybox = skybox_texture;
-	this->generateTerrains();
-	this->stitchTerrains();
-	this->generateWater();
-	this->generateParticles();
-}
-
-/* Deconstructor to safely delete when finished. */
-Scenery::~Scenery()
-{
-	for (Terrain * terrain : terrains)
-	{
-		delete(terrain);
-	}
-	for (Water * water : waters)
-	{
-		delete(water);
-	}
-	for (Particle * particle : particles)
-	{
-		delete(particle);
-	}
-}
-
-/* Generate terrains with width and height. */
-void Scenery::generateTerrains()
-{
-	//Generate terrains with width and height.
-	for (int i = 0; i < this->height; i++)
-	{
-		for (int j = 0; j < this->width; j++)
-		{
-			std::string string_blend = "../terrain/blend_maps/blend_map_" + std::to_string((width*i) + j + 1) + ".ppm";
-			const char* file_names_blend = string_blend.c_str();
-			std::string string_height = "../terrain/height_maps/height_map_" + std::to_string((width*i) + j + 1) + ".ppm";
-			const char* file_names_height = string_height.c_str();
-			Terrain * cur_terrain = new Terrain(j, i, "../terrain/texture_0.ppm", "../terrain/texture_1.ppm", "../terrain/texture_2.ppm", "../terrain/texture_3.ppm", file_names_blend, file_names_height);
-			terrains.push_back(cur_terrain);
-		}
-	}
-}
-
-/* Stitches the terrains based on the terrains array. */
-void Scenery::stitchTerrains()
-{
-	//Stitch left and right.
-	for (int i = 0; i < height; i++)
-	{
-		for (int j = 0; j < width - 1; j++)
-		{
-			terrains[(width*i) + j]->terrain_right = terrains[(width*i) + j + 1];
-			terrains[(width*i) + j + 1]->terrain_left = terrains[(width*i) + j];
-		}
-	}
-	//Stitch top and bottom.
-	for (int j = 0; j < width; j++)
-	{
-		for (int i = 0; i < height-1; i++)
-		{
-			terrains[(width*i) + j]->terrain_bottom = terrains[(width*(i+1)) + j];
-			terrains[(width*(i+1)) + j]->terrain_top = terrains[(width*i) + j];
-		}
-	}
-	for (int x = 0; x < terrains.size(); x++)
-	{
-		terrains[x]->stitch_all();
-	}
-}
-
-/* Generate water with width and height. */
-void Scenery::generateWater()
-{
-	//Generate terrains with width and height.
-	for (int i = 0; i < this->height; i++)
-	{
-		for (int j = 0; j < this->width; j++)
-		{
-			Water * cur_water = new Water(j, i, this->skybox);
-			waters.push_back(cur_water);
-		}
-	}
-}
-
-/* Generate water with width and height. */
-void Scenery::generateParticles()
-{
-	//Generate terrains with width and height.
-	for (int i = 0; i < this->height; i++)
-	{
-		for (int j = 0; j < this->width; j++)
-		{
-			Particle * cur_particle = new Particle(j, i);
-			particles.push_back(cur_particle);
-		}
-	}
-}
-
-/* Calls draw on all the terrains. */
+#include "Scenery.h"
+#include <string>
+#include <string>
+#include <sstream> 
+#include <chrono>
+#include <algorithm>
+
+#define TERRAIN_SIZE 500.0f
+#define STREAM_UPLOADS_PER_FRAME 1
+#define STREAM_ALL -1
+#define PROJECTED_COLUMNS 256
+#define PROJECTED_ROWS 256
+#define DRAW_SHADED 0
+#define DRAW_WIREFRAME 1
+
+/* Constructor to create a terrain map with a specified width and height. */
+Scenery::Scenery(int width, int height, GLuint skybox_texture)
+{
+	//Setup the width, height, and boundaries of the scene.
+	this->width = width;
+	this->height = height;
+	this->boundaries.x = width * TERRAIN_SIZE;
+	this->boundaries.y = height * TERRAIN_SIZE;
+	this->skybox = skybox_texture;
+	this->pool = new ThreadPool();
+	this->lod_enabled = true;
+	this->wireframe = false;
+	this->stats = Culling_stats();
+	this->particles_frozen = 0;
+	this->particles_live = 0;
+	this->occlusion_enabled = true;
+	this->ocean = nullptr;
+	this->projected_grid = nullptr;
+	this->radius = STREAM_ALL;
+	particle_priorities.assign(width * height, 1.0f);
+	this->generateTerrains();
+	this->stitchTerrains();
+	this->generateWater();
+	this->generateParticles();
+}
+
+/* Constructor to create a streamed terrain map with a specified width and height. Only the tiles within radius of the focus are kept in memory, the rest are loaded on the workers as the focus moves. */
+Scenery::Scenery(int width, int height, int radius, glm::vec3 focus, GLuint skybox_texture)
+{
+	//Setup the width, height, and boundaries of the scene.
+	this->width = width;
+	this->height = height;
+	this->boundaries.x = width * TERRAIN_SIZE;
+	this->boundaries.y = height * TERRAIN_SIZE;
+	this->skybox = skybox_texture;
+	this->pool = new ThreadPool();
+	this->lod_enabled = true;
+	this->wireframe = false;
+	this->stats = Culling_stats();
+	this->particles_frozen = 0;
+	this->particles_live = 0;
+	this->occlusion_enabled = true;
+	this->ocean = nullptr;
+	this->projected_grid = nullptr;
+	this->radius = radius;
+	this->all_cooked = false;
+	//No tile is resident yet.
+	terrains.assign(width * height, nullptr);
+	waters.assign(width * height, nullptr);
+	particles.assign(width * height, nullptr);
+	particle_priorities.assign(width * height, 1.0f);
+	loading.assign(width * height, nullptr);
+	//Load the first ring before returning so there is ground under the focus.
+	this->stream(focus, 0);
+	for (std::map<int, std::future<void>>::iterator it = jobs.begin(); it != jobs.end(); ++it)
+	{
+		it->second.wait();
+	}
+	this->stream(focus, STREAM_ALL);
+}
+
+/* Deconstructor to safely delete when finished. */
+Scenery::~Scenery()
+{
+	//Let any tiles still loading finish before deleting what they built.
+	delete(pool);
+	delete(ocean);
+	delete(projected_grid);
+	for (Terrain * terrain : loading)
+	{
+		delete(terrain);
+	}
+	for (Terrain * terrain : terrains)
+	{
+		delete(terrain);
+	}
+	for (Water * water : waters)
+	{
+		delete(water);
+	}
+	for (Particle * particle : particles)
+	{
+		delete(particle);
+	}
+}
+
+/* Generate terrains with width and height. The height maps are built on the workers, only the upload runs on the GL thread. Cooked tiles are used instead when every one of them is up to date. */
+void Scenery::generateTerrains()
+{
+	int count = this->width * this->height;
+	terrains.resize(count, nullptr);
+	//The cooked tiles hold the stitched result, which depends on the whole world, so every key covers every source height map.
+	std::vector<unsigned long long> sources(count);
+	pool->parallel_for(0, count, [this, &sources](int index)
+	{
+		sources[index] = TerrainCache::hashFile(getHeightMapPath(index).c_str());
+	});
+	int layout[] = { this->width, this->height };
+	unsigned long long world = TerrainCache::hash(0, layout, sizeof(layout));
+	world = TerrainCache::hash(world, &sources[0], sources.size() * sizeof(unsigned long long));
+	cook_keys.resize(count);
+	for (int index = 0; index < count; index++)
+	{
+		cook_keys[index] = Terrain::getCookKey(index % this->width, index / this->width, world);
+	}
+	//Map every cooked tile.
+	std::vector<TerrainCache*> cooked(count, nullptr);
+	pool->parallel_for(0, count, [this, &cooked](int index)
+	{
+		cooked[index] = Terrain::openCooked(getCookedPath(index, true), cook_keys[index]);
+	});
+	this->all_cooked = std::find(cooked.begin(), cooked.end(), nullptr) == cooked.end();
+	//Build the CPU side of every terrain in parallel, from the cooked tiles or from scratch if any are missing.
+	pool->parallel_for(0, count, [this, &cooked](int index)
+	{
+		int i = index / this->width;
+		int j = index % this->width;
+		if (this->all_cooked)
+		{
+			terrains[index] = new Terrain(j, i, cooked[index]);
+		}
+		else
+		{
+			delete(cooked[index]);
+			terrains[index] = new Terrain(j, i, getHeightMapPath(index).c_str());
+		}
+	});
+	//Load the textures and upload the buffers on this thread.
+	for (int index = 0; index < (int)terrains.size(); index++)
+	{
+		std::string string_blend = "../terrain/blend_maps/blend_map_" + std::to_string(index + 1) + ".ppm";
+		const char* file_names_blend = string_blend.c_str();
+		terrains[index]->setupTerrain("../terrain/texture_0.ppm", "../terrain/texture_1.ppm", "../terrain/texture_2.ppm", "../terrain/texture_3.ppm", file_names_blend);
+	}
+}
+
+/* Return the source height map of the tile at index. */
+std::string Scenery::getHeightMapPath(int index)
+{
+	return "../terrain/height_maps/height_map_" + std::to_string(index + 1) + ".ppm";
+}
+
+/* Return the cooked file of the tile at index. Stitched tiles (whole world) and unstitched tiles (streaming) are kept apart. */
+std::string Scenery::getCookedPath(int index, bool stitched)
+{
+	return "../terrain/height_maps/height_map_" + std::to_string(index + 1) + (stitched ? ".stitched.cooked" : ".cooked");
+}
+
+/* Stitches the terrains based on the terrains array. */
+void Scenery::stitchTerrains()
+{
+	//Link every terrain to its left, right, top and bottom.
+	for (int x = 0; x < terrains.size(); x++)
+	{
+		this->linkTerrain(x);
+	}
+	//Cooked tiles are already stitched.
+	if (this->all_cooked)
+		return;
+	//Stitch every edge first, then upload each terrain once. The whole tiles are dirty from setupTerrain anyway.
+	for (int x = 0; x < terrains.size(); x++)
+	{
+		terrains[x]->stitch_all();
+	}
+	for (int x = 0; x < terrains.size(); x++)
+	{
+		terrains[x]->flush();
+	}
+	//Cook the stitched tiles so the next start can skip all of this.
+	pool->parallel_for(0, (int)terrains.size(), [this](int index)
+	{
+		terrains[index]->cook(getCookedPath(index, true), cook_keys[index]);
+	});
+}
+
+/* Point the terrain at index and its resident neighbours at each other. */
+void Scenery::linkTerrain(int index)
+{
+	Terrain * terrain = terrains[index];
+	int i = index / this->width;
+	int j = index % this->width;
+	terrain->terrain_left = (j > 0) ? terrains[index - 1] : nullptr;
+	terrain->terrain_right = (j < width - 1) ? terrains[index + 1] : nullptr;
+	terrain->terrain_top = (i > 0) ? terrains[index - width] : nullptr;
+	terrain->terrain_bottom = (i < height - 1) ? terrains[index + width] : nullptr;
+	if (terrain->terrain_left)
+		terrain->terrain_left->terrain_right = terrain;
+	if (terrain->terrain_right)
+		terrain->terrain_right->terrain_left = terrain;
+	if (terrain->terrain_top)
+		terrain->terrain_top->terrain_bottom = terrain;
+	if (terrain->terrain_bottom)
+		terrain->terrain_bottom->terrain_top = terrain;
+}
+
+/* Remove the terrain at index from its neighbours before it's deleted. Their edge normals no longer read across, so the edges are uploaded again. */
+void Scenery::unlinkTerrain(int index)
+{
+	Terrain * terrain = terrains[index];
+	Terrain * neighbours[4] = { terrain->terrain_left, terrain->terrain_right, terrain->terrain_top, terrain->terrain_bottom };
+	terrain->unlink();
+	for (Terrain * neighbour : neighbours)
+	{
+		if (neighbour != nullptr)
+			neighbour->flush();
+	}
+}
+
+/* Keep the tiles within radius of the focus loaded. Tiles more than one past the radius are evicted, missing tiles are queued on the workers (closest first) and at most max_uploads finished tiles are uploaded, STREAM_ALL uploads every one. Does nothing when every tile is resident. */
+void Scenery::stream(glm::vec3 focus, int max_uploads)
+{
+	if (this->radius == STREAM_ALL)
+		return;
+	int focus_x = (int)floor(focus.x / TERRAIN_SIZE);
+	int focus_z = (int)floor(focus.z / TERRAIN_SIZE);
+	//Evict the tiles that are well outside the ring. The extra tile stops walking along an edge from reloading it.
+	for (int index = 0; index < (int)terrains.size(); index++)
+	{
+		if (terrains[index] != nullptr && getTileDistance(index, focus_x, focus_z) > radius + 1)
+		{
+			this->removeTile(index);
+		}
+	}
+	//Queue the missing tiles, ring by ring outwards from the focus.
+	for (int ring = 0; ring <= radius; ring++)
+	{
+		for (int i = focus_z - ring; i <= focus_z + ring; i++)
+		{
+			for (int j = focus_x - ring; j <= focus_x + ring; j++)
+			{
+				if (i < 0 || i >= height || j < 0 || j >= width)
+					continue;
+				int index = i * width + j;
+				if (getTileDistance(index, focus_x, focus_z) != ring || terrains[index] != nullptr || jobs.count(index) != 0)
+					continue;
+				this->loadTile(index);
+			}
+		}
+	}
+	//Upload the tiles the workers have finished, or drop them if the focus has moved away.
+	int uploads = 0;
+	std::map<int, std::future<void>>::iterator it = jobs.begin();
+	while (it != jobs.end() && (max_uploads == STREAM_ALL || uploads < max_uploads))
+	{
+		if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++it;
+			continue;
+		}
+		int index = it->first;
+		it = jobs.erase(it);
+		if (getTileDistance(index, focus_x, focus_z) > radius + 1)
+		{
+			delete(loading[index]);
+			loading[index] = nullptr;
+			continue;
+		}
+		this->addTile(index);
+		uploads++;
+	}
+}
+
+/* Build the terrain at index on a worker, from its cooked tile when there is one. Only CPU work, addTile uploads it once it's done. */
+void Scenery::loadTile(int index)
+{
+	int i = index / this->width;
+	int j = index % this->width;
+	std::string string_height = getHeightMapPath(index);
+	std::string string_cooked = getCookedPath(index, false);
+	jobs[index] = pool->enqueue([this, index, i, j, string_height, string_cooked]
+	{
+		//Streamed tiles are cooked before stitching, so the key only depends on this tile's own source.
+		unsigned long long key = Terrain::getCookKey(j, i, TerrainCache::hashFile(string_height.c_str()));
+		TerrainCache * cooked = Terrain::openCooked(string_cooked, key);
+		if (cooked != nullptr)
+		{
+			loading[index] = new Terrain(j, i, cooked);
+		}
+		else
+		{
+			loading[index] = new Terrain(j, i, string_height.c_str());
+			loading[index]->cook(string_cooked, key);
+		}
+	});
+}
+
+/* Upload a loaded terrain, stitch it to the resident neighbours and create its water and particles. */
+void Scenery::addTile(int index)
+{
+	int i = index / this->width;
+	int j = index % this->width;
+	Terrain * terrain = loading[index];
+	loading[index] = nullptr;
+	std::string string_blend = "../terrain/blend_maps/blend_map_" + std::to_string(index + 1) + ".ppm";
+	terrain->setupTerrain("../terrain/texture_0.ppm", "../terrain/texture_1.ppm", "../terrain/texture_2.ppm", "../terrain/texture_3.ppm", string_blend.c_str());
+	terrains[index] = terrain;
+	this->linkTerrain(index);
+	//Stitching moves the neighbours' edges too, only the rows and columns it touched are uploaded on them.
+	terrain->stitch_all();
+	Terrain * neighbours[5] = { terrain, terrain->terrain_left, terrain->terrain_right, terrain->terrain_top, terrain->terrain_bottom };
+	for (Terrain * neighbour : neighbours)
+	{
+		if (neighbour == nullptr)
+			continue;
+		neighbour->flush();
+	}
+	waters[index] = new Water(j, i, this->skybox);
+	particles[index] = new Particle(j, i);
+	particles[index]->setPriority(particle_priorities[index]);
+	//Match the draw mode of the tiles already showing.
+	if (this->wireframe)
+	{
+		terrain->toggleDrawMode();
+		waters[index]->toggleDrawMode();
+	}
+}
+
+/* Unlink and delete everything on the tile at index. */
+void Scenery::removeTile(int index)
+{
+	this->unlinkTerrain(index);
+	delete(terrains[index]);
+	delete(waters[index]);
+	//Its update may still be running.
+	this->wait_particles();
+	delete(particles[index]);
+	terrains[index] = nullptr;
+	waters[index] = nullptr;
+	particles[index] = nullptr;
+}
+
+/* Return how many tiles away from the focus tile the tile at index is, in rings. */
+int Scenery::getTileDistance(int index, int focus_x, int focus_z)
+{
+	int i = index / this->width;
+	int j = index % this->width;
+	return glm::max(abs(j - focus_x), abs(i - focus_z));
+}
+
+/* Stream tiles in and out around the focus, call once per frame. */
+void Scenery::update_streaming(glm::vec3 focus)
+{
+	this->stream(focus, STREAM_UPLOADS_PER_FRAME);
+}
+
+/* Generate water with width and height. */
+void Scenery::generateWater()
+{
+	//Generate terrains with width and height.
+	for (int i = 0; i < this->height; i++)
+	{
+		for (int j = 0; j < this->width; j++)
+		{
+			Water * cur_water = new Water(j, i, this->skybox);
+			waters.push_back(cur_water);
+		}
+	}
+}
+
+/* Generate water with width and height. */
+void Scenery::generateParticles()
+{
+	//Generate terrains with width and height.
+	for (int i = 0; i < this->height; i++)
+	{
+		for (int j = 0; j < this->width; j++)
+		{
+			Particle * cur_particle = new Particle(j, i);
+			particles.push_back(cur_particle);
+		}
+	}
+}
+
+/* Pick every terrain patch's level of detail for this camera, then relax them until neighbouring patches (across terrains too) are at most one level apart so the edges can be stitched without cracks. */
+void Scenery::selectLOD(glm::vec3 camera)
+{
+	for (int i = 0; i < terrains.size(); i++)
+	{
+		if (terrains[i] != nullptr)
+			terrains[i]->selectLOD(camera, this->lod_enabled);
+	}
+	bool changed = this->lod_enabled;
+	while (changed)
+	{
+		changed = false;
+		for (int i = 0; i < terrains.size(); i++)
+		{
+			if (terrains[i] != nullptr && terrains[i]->limitLOD())
+			{
+				changed = true;
+			}
+		}
+	}
+}
+
+/* Update the frustum and build the horizon. Visible terrains are visited nearest first: each is tested against the horizon the nearer ones raised, and if it's still visible its quadtree nodes raise it further. */
+void Scenery::update_culling()
+{
+	glm::vec3 camera = Window::camera_pos;
+	this->frustum.update(Window::P * Window::V);
+	this->horizon.reset(camera);
+	stats = Culling_stats();
+	//The terrains in the frustum, nearest first.
+	terrain_visible.assign(terrains.size(), false);
+	cull_order.clear();
+	for (int i = 0; i < terrains.size(); i++)
+	{
+		if (terrains[i] == nullptr)
+			continue;
+		if (!frustum.isVisible(terrains[i]->getBounds()))
+		{
+			stats.terrains_culled++;
+			continue;
+		}
+		cull_order.push_back(i);
+	}
+	std::sort(cull_order.begin(), cull_order.end(), [this, camera](int a, int b)
+	{
+		AABB box_a = terrains[a]->getBounds();
+		AABB box_b = terrains[b]->getBounds();
+		glm::vec2 point(camera.x, camera.z);
+		float distance_a = glm::length(glm::clamp(point, glm::vec2(box_a.lower.x, box_a.lower.z), glm::vec2(box_a.upper.x, box_a.upper.z)) - point);
+		float distance_b = glm::length(glm::clamp(point, glm::vec2(box_b.lower.x, box_b.lower.z), glm::vec2(box_b.upper.x, box_b.upper.z)) - point);
+		return distance_a < distance_b;
+	});
+	for (int i : cull_order)
+	{
+		if (this->occlusion_enabled && horizon.isOccluded(terrains[i]->getBounds()))
+		{
+			stats.terrains_occluded++;
+			continue;
+		}
+		terrain_visible[i] = true;
+		stats.terrains_drawn++;
+		if (!this->occlusion_enabled)
+			continue;
+		occluders.clear();
+		terrains[i]->getOccluders(occluders);
+		for (const AABB &box : occluders)
+		{
+			horizon.addOccluder(box);
+		}
+	}
+}
+
+/* Test a box against the frustum and horizon from update_culling. */
+bool Scenery::isVisible(const AABB &box)
+{
+	if (!frustum.isVisible(box))
+		return false;
+	if (this->occlusion_enabled && horizon.isOccluded(box))
+	{
+		stats.objects_occluded++;
+		return false;
+	}
+	stats.objects_drawn++;
+	return true;
+}
+
+/* Calls draw on the terrains update_culling found visible. */
 void Scenery::draw_terrain(GLuint shaderProgram)
-{
-	for (int i = 0; i < terrains.size(); i++)
-	{
-		terrains[i]->draw(shaderProgram);
-	}
-}
-
-/* Calls draw on all the waters. */
+{
+	this->selectLOD(Window::camera_pos);
+	for (int i = 0; i < terrains.size(); i++)
+	{
+		if (terrains[i] == nullptr)
+			continue;
+		//Upload anything sculpted since the last frame, culled terrains too since their edges may have moved with a neighbour.
+		terrains[i]->flush();
+		if (terrain_visible.size() == terrains.size() && !terrain_visible[i])
+			continue;
+		terrains[i]->draw(shaderProgram);
+	}
+}
+
+/* Draws all the waters in the frustum and above the horizon in one instanced call, or the projected grid in their place. */
 void Scenery::draw_water(GLuint shaderProgram)
-{
-	for (int i = 0; i < waters.size(); i++)
-	{
-		waters[i]->draw(shaderProgram);
-	}
-}
-
-/* Calls draw on all the particles. */
+{
+	stats.waters_drawn = 0;
+	stats.waters_culled = 0;
+	stats.waters_occluded = 0;
+	visible_waters.clear();
+	//Sample the waves at the same time they're drawn at.
+	float time = (float)glfwGetTime();
+	waves.setTime(time);
+	//The ocean's waves reach further than the ripples the boxes allow for.
+	glm::vec3 margin(0.0f);
+	if (ocean != nullptr)
+	{
+		ocean->update(time);
+		glm::vec2 extent = ocean->getExtent();
+		margin = glm::vec3(extent.x, extent.y, extent.x);
+	}
+	//The projected grid is one draw that covers all the water in view, the tiles aren't used.
+	if (projected_grid != nullptr)
+	{
+		bool drawn = projected_grid->draw(shaderProgram, time, this->wireframe ? DRAW_WIREFRAME : DRAW_SHADED, this->skybox, ocean);
+		stats.waters_drawn = drawn ? 1 : 0;
+		return;
+	}
+	for (int i = 0; i < waters.size(); i++)
+	{
+		if (waters[i] == nullptr)
+			continue;
+		AABB box = waters[i]->getBounds();
+		box.lower -= margin;
+		box.upper += margin;
+		if (!frustum.isVisible(box))
+		{
+			stats.waters_culled++;
+			continue;
+		}
+		if (this->occlusion_enabled && horizon.isOccluded(box))
+		{
+			stats.waters_occluded++;
+			continue;
+		}
+		visible_waters.push_back(waters[i]);
+		stats.waters_drawn++;
+	}
+	Water::draw(shaderProgram, visible_waters, time, ocean);
+}
+
+/* Draws all the particles in the frustum, in one instanced call. */
 void Scenery::draw_particles(GLuint shaderProgram)
-{
-	for (int i = 0; i < particles.size(); i++)
-	{
-		particles[i]->draw(shaderProgram);
-	}
-}
-
-/* Toggles the draw mode for wireframe mode or fill mode. */
-void Scenery::toggleDrawMode()
-{
-	for (int i = 0; i < terrains.size(); i++)
-	{
-		terrains[i]->toggleDrawMode();
-	}
-	for (int i = 0; i < waters.size(); i++)
-	{
-		waters[i]->toggleDrawMode();
-	}
-}
-
-/* Return the terrain number that the object is currently in. */
-int Scenery::getTerrain(glm::vec3 position)
-{
-	float position_x = position.x / TERRAIN_SIZE;
-	float position_z = position.z / TERRAIN_SIZE;
-
-	if (position_x >= width || position_x < 0 || position_z >= height || position_z < 0) {
-		printf("Accessing a point out of bounds of this Scenery. Please check to make sure we're accessing the proper coordinates.\n");
-		return 0;
-	}
-
-	int terrain_x = (int)floor(position_x);
-	int terrain_z = (int)floor(position_z);
-
-	return (terrain_z*width + terrain_x);
-}
-
-/* Return the height for the given terrain (given position in the world). */
-float Scenery::getHeight(glm::vec3 position)
-{
-	Terrain * terrain = terrains[getTerrain(position)];
-	return terrain->getHeight(position);
-}
-
-/* Return the boundaries of the scenery. */
-glm::vec2 Scenery::getBounds()
-{
-	glm::vec2 toReturn = this->boundaries;
-	return toReturn;
-}
-
-/* Update the particles for animation. */
-void Scenery::update_particles()
-{
-	for (int i = 0; i < particles.size(); i++)
-	{
-		particles[i]->update();
-	}
-}
+{
+	stats.particles_drawn = 0;
+	stats.particles_culled = 0;
+	visible_particles.clear();
+	for (int i = 0; i < particles.size(); i++)
+	{
+		//Frozen emitters are counted by update_particles.
+		if (particles[i] == nullptr || particles[i]->isFrozen())
+			continue;
+		if (!frustum.isVisible(particles[i]->getBounds()))
+		{
+			stats.particles_culled++;
+			continue;
+		}
+		visible_particles.push_back(particles[i]);
+		stats.particles_drawn++;
+	}
+	Particle::draw(shaderProgram, visible_particles);
+}
+
+/* Toggles the draw mode for wireframe mode or fill mode. */
+void Scenery::toggleDrawMode()
+{
+	this->wireframe = !this->wireframe;
+	for (int i = 0; i < terrains.size(); i++)
+	{
+		if (terrains[i] != nullptr)
+			terrains[i]->toggleDrawMode();
+	}
+	for (int i = 0; i < waters.size(); i++)
+	{
+		if (waters[i] != nullptr)
+			waters[i]->toggleDrawMode();
+	}
+}
+
+/* Toggles the terrain level of detail, off draws every patch at full detail. */
+void Scenery::toggleLOD()
+{
+	this->lod_enabled = !this->lod_enabled;
+}
+
+/* Toggles horizon occlusion, off only culls against the frustum. */
+void Scenery::toggleOcclusion()
+{
+	this->occlusion_enabled = !this->occlusion_enabled;
+}
+
+/* Toggles the FFT ocean, off goes back to the ripples. */
+void Scenery::toggleOcean()
+{
+	if (ocean != nullptr)
+	{
+		delete(ocean);
+		ocean = nullptr;
+	}
+	else
+	{
+		ocean = new Ocean(pool, ocean_settings);
+		ocean_settings = ocean->getSettings();
+	}
+}
+
+/* Toggles between the tiles' meshes and one grid projected from the camera out to the horizon. */
+void Scenery::toggleProjectedWater()
+{
+	if (projected_grid != nullptr)
+	{
+		delete(projected_grid);
+		projected_grid = nullptr;
+	}
+	else
+	{
+		projected_grid = new ProjectedGrid(PROJECTED_COLUMNS, PROJECTED_ROWS);
+	}
+}
+
+/* Replace the ocean's settings, rebuilding it if it's on. */
+void Scenery::setOceanSettings(Ocean_settings settings)
+{
+	this->ocean_settings = settings;
+	if (ocean != nullptr)
+	{
+		delete(ocean);
+		ocean = new Ocean(pool, ocean_settings);
+		ocean_settings = ocean->getSettings();
+	}
+}
+
+Ocean_settings Scenery::getOceanSettings()
+{
+	return ocean_settings;
+}
+
+/* Return the terrain number that the object is currently in. */
+int Scenery::getTerrain(glm::vec3 position)
+{
+	float position_x = position.x / TERRAIN_SIZE;
+	float position_z = position.z / TERRAIN_SIZE;
+
+	if (position_x >= width || position_x < 0 || position_z >= height || position_z < 0) {
+		printf("Accessing a point out of bounds of this Scenery. Please check to make sure we're accessing the proper coordinates.\n");
+		return 0;
+	}
+
+	int terrain_x = (int)floor(position_x);
+	int terrain_z = (int)floor(position_z);
+
+	return (terrain_z*width + terrain_x);
+}
+
+/* Return the height for the given terrain (given position in the world). */
+float Scenery::getHeight(glm::vec3 position)
+{
+	Terrain * terrain = terrains[getTerrain(position)];
+	//The tile hasn't streamed in yet.
+	if (terrain == nullptr)
+		return 0;
+	return terrain->getHeight(position);
+}
+
+/* Return the heights for many positions at once. The queries are bucketed by terrain and each terrain answers its bucket in one batch. Positions off the scenery or on tiles that aren't loaded get 0, nothing is printed. */
+void Scenery::getHeights(const std::vector<glm::vec3> &positions, std::vector<float> &heights)
+{
+	int count = (int)positions.size();
+	int tiles = this->width * this->height;
+	heights.assign(count, 0.0f);
+	if (count == 0)
+		return;
+	//Count the queries per terrain, -1 for the ones with no terrain.
+	query_tiles.resize(count);
+	query_offsets.assign(tiles + 1, 0);
+	for (int n = 0; n < count; n++)
+	{
+		int terrain_x = (int)floor(positions[n].x / TERRAIN_SIZE);
+		int terrain_z = (int)floor(positions[n].z / TERRAIN_SIZE);
+		int tile = -1;
+		if (terrain_x >= 0 && terrain_x < width && terrain_z >= 0 && terrain_z < height && terrains[terrain_z*width + terrain_x] != nullptr)
+		{
+			tile = terrain_z*width + terrain_x;
+			query_offsets[tile + 1]++;
+		}
+		query_tiles[n] = tile;
+	}
+	//Turn the counts into where each terrain's bucket starts, then fill the buckets.
+	for (int tile = 0; tile < tiles; tile++)
+	{
+		query_offsets[tile + 1] += query_offsets[tile];
+	}
+	query_order.resize(query_offsets[tiles]);
+	std::vector<int> fill(query_offsets.begin(), query_offsets.end() - 1);
+	for (int n = 0; n < count; n++)
+	{
+		if (query_tiles[n] >= 0)
+		{
+			query_order[fill[query_tiles[n]]++] = n;
+		}
+	}
+	//Answer each bucket.
+	for (int tile = 0; tile < tiles; tile++)
+	{
+		int begin = query_offsets[tile];
+		int end = query_offsets[tile + 1];
+		if (end > begin)
+		{
+			terrains[tile]->getHeights(&positions[0], &query_order[begin], end - begin, &heights[0]);
+		}
+	}
+}
+
+/* Cast a ray against the terrain. Tiles are visited in the order the ray crosses them (a 2D DDA over the tile grid), so the first tile with a hit has the nearest one. Tiles that aren't loaded are passed through. */
+bool Scenery::raycast(glm::vec3 origin, glm::vec3 direction, float max_distance, glm::vec3 &hit)
+{
+	if (glm::length(direction) == 0.0f)
+		return false;
+	direction = glm::normalize(direction);
+	//Clip the ray to the scenery's xz bounds.
+	float enter = 0.0f, exit = max_distance;
+	for (int c = 0; c < 3; c += 2)
+	{
+		float bound = (c == 0) ? this->boundaries.x : this->boundaries.y;
+		if (direction[c] == 0.0f)
+		{
+			if (origin[c] < 0.0f || origin[c] > bound)
+				return false;
+			continue;
+		}
+		float t0 = (0.0f - origin[c]) / direction[c];
+		float t1 = (bound - origin[c]) / direction[c];
+		enter = glm::max(enter, glm::min(t0, t1));
+		exit = glm::min(exit, glm::max(t0, t1));
+	}
+	if (enter > exit)
+		return false;
+	//Start in the tile the ray enters and step to whichever tile border is crossed next.
+	glm::vec3 start = origin + direction * enter;
+	int tile_x = glm::clamp((int)floor(start.x / TERRAIN_SIZE), 0, width - 1);
+	int tile_z = glm::clamp((int)floor(start.z / TERRAIN_SIZE), 0, height - 1);
+	int step_x = (direction.x > 0.0f) ? 1 : -1;
+	int step_z = (direction.z > 0.0f) ? 1 : -1;
+	float next_x = (direction.x != 0.0f) ? ((tile_x + (step_x > 0)) * TERRAIN_SIZE - origin.x) / direction.x : INFINITY;
+	float next_z = (direction.z != 0.0f) ? ((tile_z + (step_z > 0)) * TERRAIN_SIZE - origin.z) / direction.z : INFINITY;
+	float delta_x = (direction.x != 0.0f) ? TERRAIN_SIZE / fabs(direction.x) : INFINITY;
+	float delta_z = (direction.z != 0.0f) ? TERRAIN_SIZE / fabs(direction.z) : INFINITY;
+	while (tile_x >= 0 && tile_x < width && tile_z >= 0 && tile_z < height)
+	{
+		Terrain * terrain = terrains[tile_z * width + tile_x];
+		float distance;
+		if (terrain != nullptr && terrain->raycast(origin, direction, exit, distance))
+		{
+			hit = origin + direction * distance;
+			return true;
+		}
+		//Past the end of the ray.
+		if (glm::min(next_x, next_z) > exit)
+			break;
+		if (next_x < next_z)
+		{
+			tile_x += step_x;
+			next_x += delta_x;
+		}
+		else
+		{
+			tile_z += step_z;
+			next_z += delta_z;
+		}
+	}
+	return false;
+}
+
+/* Sculpt the terrains under the brush. Every terrain works out its new heights before any are written, so the edges shared between them stay matched. */
+void Scenery::sculpt(Brush brush)
+{
+	int x0 = glm::max((int)floor((brush.center.x - brush.radius) / TERRAIN_SIZE), 0);
+	int x1 = glm::min((int)floor((brush.center.x + brush.radius) / TERRAIN_SIZE), width - 1);
+	int z0 = glm::max((int)floor((brush.center.z - brush.radius) / TERRAIN_SIZE), 0);
+	int z1 = glm::min((int)floor((brush.center.z + brush.radius) / TERRAIN_SIZE), height - 1);
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int i = z0; i <= z1; i++)
+		{
+			for (int j = x0; j <= x1; j++)
+			{
+				Terrain * terrain = terrains[i * width + j];
+				if (terrain == nullptr)
+					continue;
+				if (pass == 0)
+					terrain->sculpt(brush);
+				else
+					terrain->applySculpt();
+			}
+		}
+	}
+}
+
+/* Return the height of the water surface at the position. */
+float Scenery::getWaterHeight(glm::vec3 position)
+{
+	if (ocean != nullptr)
+		return ocean->sampleHeight(position);
+	return waves.sampleHeight(position);
+}
+
+/* Return the water heights for many positions at once. */
+void Scenery::getWaterHeights(const std::vector<glm::vec3> &positions, std::vector<float> &heights)
+{
+	heights.resize(positions.size());
+	if (ocean != nullptr)
+	{
+		for (int i = 0; i < positions.size(); i++)
+		{
+			heights[i] = ocean->sampleHeight(positions[i]);
+		}
+	}
+	else if (!positions.empty())
+		waves.sampleHeights(&positions[0], (int)positions.size(), &heights[0]);
+}
+
+/* Return the water normals for many positions at once. */
+void Scenery::getWaterNormals(const std::vector<glm::vec3> &positions, std::vector<glm::vec3> &normals)
+{
+	normals.resize(positions.size());
+	if (ocean != nullptr)
+	{
+		for (int i = 0; i < positions.size(); i++)
+		{
+			normals[i] = ocean->sampleNormal(positions[i]);
+		}
+	}
+	else if (!positions.empty())
+		waves.sampleNormals(&positions[0], (int)positions.size(), &normals[0]);
+}
+
+/* Return the boundaries of the scenery. */
+glm::vec2 Scenery::getBounds()
+{
+	glm::vec2 toReturn = this->boundaries;
+	return toReturn;
+}
+
+/* Change the particle budget, the next update_particles shares out the new one. */
+void Scenery::setParticleBudget(Particle_budget_settings settings)
+{
+	particle_budget.setSettings(settings);
+}
+
+/* Return the particle budget and how it's shared. */
+Particle_budget_settings Scenery::getParticleBudget()
+{
+	return particle_budget.getSettings();
+}
+
+/* Set the priority of the tile at position, and of its emitter if it's resident. */
+void Scenery::setParticlePriority(glm::vec3 position, float priority)
+{
+	//getTerrain falls back to tile 0 outside the scenery, which would change the wrong tile.
+	if (position.x < 0 || position.x >= boundaries.x || position.z < 0 || position.z >= boundaries.y)
+		return;
+	int index = getTerrain(position);
+	particle_priorities[index] = priority;
+	if (particles[index] != nullptr)
+		particles[index]->setPriority(priority);
+}
+
+/* Return the priority of the tile at position, 0 outside the scenery. */
+float Scenery::getParticlePriority(glm::vec3 position)
+{
+	if (position.x < 0 || position.x >= boundaries.x || position.z < 0 || position.z >= boundaries.y)
+		return 0.0f;
+	return particle_priorities[getTerrain(position)];
+}
+
+/* Return what the frustum culling kept and skipped in the last frame, with what the particle budget froze and left alive. */
+Culling_stats Scenery::getCullingStats()
+{
+	Culling_stats result = this->stats;
+	result.particles_frozen = this->particles_frozen;
+	result.particles_live = this->particles_live;
+	return result;
+}
+
+/* Show the update that ran during the last frame, then start the next one on the workers. Each emitter is split into chunks and the chunks are shared out like parallel_for does, but nothing waits for them until the next call. */
+void Scenery::update_particles()
+{
+	this->wait_particles();
+	for (Particle * particle : particles)
+	{
+		if (particle != nullptr)
+			particle->swap();
+	}
+	//Share the budget out from last frame's camera, frozen emitters keep what they have and don't update.
+	particle_budget.update(particles, Window::camera_pos, frustum);
+	particles_frozen = 0;
+	particles_live = 0;
+	//Spawning happens here, the workers only simulate.
+	double time = glfwGetTime();
+	particle_chunks.clear();
+	for (Particle * particle : particles)
+	{
+		if (particle == nullptr)
+			continue;
+		if (particle->isFrozen())
+		{
+			particles_frozen++;
+			continue;
+		}
+		int chunks = particle->prepare(time);
+		particles_live += particle->getAlive();
+		for (int chunk = 0; chunk < chunks; chunk++)
+		{
+			particle_chunks.push_back(std::make_pair(particle, chunk));
+		}
+	}
+	int count = (int)particle_chunks.size();
+	int jobs = std::min((int)pool->size(), count);
+	for (int job = 0; job < jobs; job++)
+	{
+		int start = count * job / jobs;
+		int stop = count * (job + 1) / jobs;
+		particle_jobs.push_back(pool->enqueue([this, start, stop]
+		{
+			for (int i = start; i < stop; i++)
+			{
+				particle_chunks[i].first->simulate(particle_chunks[i].second);
+			}
+		}));
+	}
+}
+
+/* Wait for the particle update on the workers, if one is running. */
+void Scenery::wait_particles()
+{
+	for (std::future<void> &job : particle_jobs)
+	{
+		job.wait();
+	}
+	particle_jobs.clear();
+}
@@ -1,49 +1,142 @@
-#pragma once
-#pragma once
-#ifndef SCENERY_H
-#define SCENERY_H
-
-#include "Window.h"
-#include "Definitions.h"
-#include "Terrain.h"
-#include "Water.h"
-#include "Particle.h"
-
-class Scenery
-{
-private:
-	//Contain the width and height of the scenery.
-	int width;
-	int height;
-	glm::vec2 boundaries;
-	GLuint skybox;
-	//Access elements from the scenery class.
-	std::vector<Terrain*> terrains;
-	std::vector<Water*> waters;
-	std::vector<Particle*> particles;
-	//Terrains
-	void generateTerrains();
-	void stitchTerrains();
-	int getTerrain(glm::vec3 position);
-	//Water
-	void generateWater();
-	//Particles
-	void generateParticles();
-
-public:
-	//Constructor methods.
-	Scenery(int width, int height, GLuint skybox_texture);
-	~Scenery();
-
-	float getHeight(glm::vec3 position);
-	glm::vec2 getBounds();
-
-	void toggleDrawMode();
-
-	void draw_terrain(GLuint shaderProgram);
-	void draw_water(GLuint shaderProgram);
-	void draw_particles(GLuint shaderProgram);
-
-	void update_particles();
-};
+#pragma once
+#pragma once
+#ifndef SCENERY_H
+#define SCENERY_H
+
+#include "Window.h"
+#include "Definitions.h"
+#include "Terrain.h"
+#include "Water.h"
+#include "Particle.h"
+#include "ThreadPool.h"
+#include "Frustum.h"
+#include "HorizonCuller.h"
+#include "WaveModel.h"
+#include "Ocean.h"
+#include "ProjectedGrid.h"
+#include "ParticleBudget.h"
+#include <map>
+
+class Scenery
+{
+private:
+	//Contain the width and height of the scenery.
+	int width;
+	int height;
+	glm::vec2 boundaries;
+	GLuint skybox;
+	//Workers for CPU side generation.
+	ThreadPool * pool;
+	//Draw far terrain patches with fewer triangles.
+	bool lod_enabled;
+	//Skip tiles outside the camera's view.
+	Frustum frustum;
+	Culling_stats stats;
+	//Skip what's hidden behind hills: the horizon is raised by the visible terrains, nearest first, and everything else is tested against it.
+	HorizonCuller horizon;
+	bool occlusion_enabled;
+	std::vector<bool> terrain_visible;
+	std::vector<int> cull_order;
+	std::vector<AABB> occluders;
+	//Access elements from the scenery class. When streaming, tiles that aren't resident are nullptr.
+	std::vector<Terrain*> terrains;
+	std::vector<Water*> waters;
+	std::vector<Particle*> particles;
+	bool wireframe;
+	//Streaming: tiles within radius of the focus stay resident, STREAM_ALL (-1) keeps every tile. Terrains being built on the workers land in loading once their job is done.
+	int radius;
+	std::vector<Terrain*> loading;
+	std::map<int, std::future<void>> jobs;
+	void stream(glm::vec3 focus, int max_uploads);
+	void loadTile(int index);
+	void addTile(int index);
+	void removeTile(int index);
+	int getTileDistance(int index, int focus_x, int focus_z);
+	//Terrains
+	void generateTerrains();
+	void stitchTerrains();
+	void linkTerrain(int index);
+	//Cooked tiles: one key per tile, and whether every tile was loaded from one.
+	std::vector<unsigned long long> cook_keys;
+	bool all_cooked;
+	std::string getHeightMapPath(int index);
+	std::string getCookedPath(int index, bool stitched);
+	void unlinkTerrain(int index);
+	void selectLOD(glm::vec3 camera);
+	int getTerrain(glm::vec3 position);
+	//Scratch space for getHeights: the terrain of each query, where each terrain's queries start and the queries in terrain order.
+	std::vector<int> query_tiles;
+	std::vector<int> query_offsets;
+	std::vector<int> query_order;
+	//Water, the tiles drawn this frame and the ripples they were drawn with.
+	std::vector<Water*> visible_waters;
+	WaveModel waves;
+	//The FFT ocean every tile shows instead of the ripples, nullptr while it's off.
+	Ocean * ocean;
+	Ocean_settings ocean_settings;
+	//One grid projected from the camera that replaces the tiles' meshes, nullptr while it's off.
+	ProjectedGrid * projected_grid;
+	void generateWater();
+	//Particles, and the emitters drawn this frame.
+	std::vector<Particle*> visible_particles;
+	void generateParticles();
+	//The particle update running on the workers while the last one is drawn: every emitter's chunks, and the jobs working through them.
+	std::vector<std::pair<Particle*, int>> particle_chunks;
+	std::vector<std::future<void>> particle_jobs;
+	void wait_particles();
+	//Shares the live particles out between the emitters every frame. Each tile's priority is kept here so it survives the tile being streamed out.
+	ParticleBudget particle_budget;
+	std::vector<float> particle_priorities;
+	//What the last update_particles froze and left alive. Kept out of stats, which update_culling clears every frame before the update runs.
+	int particles_frozen;
+	int particles_live;
+
+public:
+	//Constructor methods.
+	Scenery(int width, int height, GLuint skybox_texture);
+	Scenery(int width, int height, int radius, glm::vec3 focus, GLuint skybox_texture);
+	~Scenery();
+
+	float getHeight(glm::vec3 position);
+	//Batched getHeight for many positions, e.g. snapping particles or objects to the ground every frame.
+	void getHeights(const std::vector<glm::vec3> &positions, std::vector<float> &heights);
+	glm::vec2 getBounds();
+	//Height and normal of the rippling water surface, as last drawn.
+	float getWaterHeight(glm::vec3 position);
+	void getWaterHeights(const std::vector<glm::vec3> &positions, std::vector<float> &heights);
+	void getWaterNormals(const std::vector<glm::vec3> &positions, std::vector<glm::vec3> &normals);
+	//Nearest point within max_distance where the ray hits resident terrain, for picking, line of sight and camera collision.
+	bool raycast(glm::vec3 origin, glm::vec3 direction, float max_distance, glm::vec3 &hit);
+
+	//Sculpt every loaded terrain under the brush. The changes are uploaded by the next draw_terrain, once per terrain.
+	void sculpt(Brush brush);
+
+	void toggleDrawMode();
+	void toggleLOD();
+	void toggleOcclusion();
+	void toggleOcean();
+	void toggleProjectedWater();
+	//Change the ocean's resolution, update rate or spectrum. It's rebuilt if it's on.
+	void setOceanSettings(Ocean_settings settings);
+	Ocean_settings getOceanSettings();
+	//Change the particle budget or how it's shared, from the next update on.
+	void setParticleBudget(Particle_budget_settings settings);
+	Particle_budget_settings getParticleBudget();
+	//Weigh the share of the particles on the tile at position, 1 by default and 0 freezes them. Positions outside the scenery are ignored.
+	void setParticlePriority(glm::vec3 position, float priority);
+	float getParticlePriority(glm::vec3 position);
+
+	void draw_terrain(GLuint shaderProgram);
+	void draw_water(GLuint shaderProgram);
+	void draw_particles(GLuint shaderProgram);
+
+	void update_particles();
+	void update_streaming(glm::vec3 focus);
+	//Work out what's visible from the camera this frame. Call once per frame before any draw.
+	void update_culling();
+	//Test an object's box against this frame's frustum and horizon, counted in the stats.
+	bool isVisible(const AABB &box);
+	//How many tiles and objects the last frame drew, culled and found hidden.
+	Culling_stats getCullingStats();
+};
 #endif
\ No newline at end of file
@@ -1,728 +1,1313 @@
-#include "Terrain.h"
-#include "SkyBox.h"
-#include <time.h>
-#include <math.h>
-
-using namespace std;
-
-#define SIZE 500
-#define VERTEX_COUNT 128
-#define MAX_HEIGHT 40
-#define MAX_DISPLACEMENT 0.01f
-#define DRAW_SHADED 0
-#define DRAW_WIREFRAME 1
-#define SCENE_MODE 0
-
-/* Flat Terrain. Ability to input a height map: either real or generated from different applications. Shader that adds at least 3 different type of terrain(grass, desert, snow). */
-Terrain::Terrain(int x_d, int z_d, const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map)
-{
-	//Setup the terrain.
-	this->x = x_d * SIZE;
-	this->z = z_d * SIZE;
-	this->draw_mode = DRAW_SHADED;
-	//Setup toWorld so that the terrain is at the center of the world.
-	this->toWorld = glm::mat4(1.0f);
-	glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->x, 0, this->z));
-	this->toWorld = translate*this->toWorld;
-	//Setup HeightMap
-	this->setupHeightMap();
-	//Load the texture and setup VAO, VBO for the terrains.
-	this->setupTerrain(terrain_0, terrain_1, terrain_2, terrain_3, blend_map);
-}
-
-/* Procedurally generated Terrain. Ability to input a height map: either real or generated from different applications. Shader that adds at least 3 different type of terrain(grass, desert, snow). */
-Terrain::Terrain(int x_d, int z_d, const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map, const char* height_map)
-{
-	//Setup the terrain.
-	this->x = x_d * SIZE;
-	this->z = z_d * SIZE;
-	this->draw_mode = DRAW_SHADED;
-	//Setup toWorld so that the terrain is at the center of the world.
-	this->toWorld = glm::mat4(1.0f);
-	glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->x, 0, this->z));
-	this->toWorld = translate*this->toWorld;
-	//Setup HeightMap
-	this->setupHeightMap(height_map, 16.0f, 4.0f);
-	//Load the texture and setup VAO, VBO for the terrains.
-	this->setupTerrain(terrain_0, terrain_1, terrain_2, terrain_3, blend_map);
-}
-
-/* Deconstructor to safely delete when finished. */
-Terrain::~Terrain()
-{
+#include "Terrain.h"
+#include "SkyBox.h"
+#include "TerrainGrid.h"
+#include "TextureCache.h"
+#include <math.h>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TERRAIN_SSE
+#endif
+
+using namespace std;
+
+#define SIZE 500
+#define VERTEX_COUNT 129
+#define MAX_HEIGHT 40
+#define MAX_DISPLACEMENT 0.01f
+#define DRAW_SHADED 0
+#define DRAW_WIREFRAME 1
+#define SCENE_MODE 0
+#define DIRTY_MERGE_GAP VERTEX_COUNT
+#define TERRAIN_SEED 0x9E3779B9u
+#define PATCH_SIZE 32
+#define N_SMOOTH 16.0f
+#define N_RANGE 4.0f
+#define LOD_DISTANCE 150.0f
+#define OCCLUDER_NODES 8
+//Sides of the terrain, in the order source_edges keeps them.
+#define EDGE_LEFT 0
+#define EDGE_RIGHT 1
+#define EDGE_TOP 2
+#define EDGE_BOTTOM 3
+
+/* Flat Terrain. Ability to input a height map: either real or generated from different applications. Shader that adds at least 3 different type of terrain(grass, desert, snow). */
+Terrain::Terrain(int x_d, int z_d, const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map)
+{
+	//Setup the terrain.
+	this->x = x_d * SIZE;
+	this->z = z_d * SIZE;
+	this->draw_mode = DRAW_SHADED;
+	this->terrain_top = nullptr;
+	this->terrain_bottom = nullptr;
+	this->terrain_left = nullptr;
+	this->terrain_right = nullptr;
+	this->cooked = nullptr;
+	//Setup toWorld so that the terrain is at the center of the world.
+	this->toWorld = glm::mat4(1.0f);
+	glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->x, 0, this->z));
+	this->toWorld = translate*this->toWorld;
+	//Setup HeightMap
+	this->setupHeightMap();
+	//Load the texture and setup VAO, VBO for the terrains.
+	this->setupTerrain(terrain_0, terrain_1, terrain_2, terrain_3, blend_map);
+	this->flush();
+}
+
+/* Procedurally generated Terrain. Ability to input a height map: either real or generated from different applications. Shader that adds at least 3 different type of terrain(grass, desert, snow). */
+Terrain::Terrain(int x_d, int z_d, const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map, const char* height_map)
+{
+	//Setup the terrain.
+	this->x = x_d * SIZE;
+	this->z = z_d * SIZE;
+	this->draw_mode = DRAW_SHADED;
+	this->terrain_top = nullptr;
+	this->terrain_bottom = nullptr;
+	this->terrain_left = nullptr;
+	this->terrain_right = nullptr;
+	this->cooked = nullptr;
+	//Setup toWorld so that the terrain is at the center of the world.
+	this->toWorld = glm::mat4(1.0f);
+	glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->x, 0, this->z));
+	this->toWorld = translate*this->toWorld;
+	//Seed the terrain's noise from its position so it generates the same every time.
+	this->seed = Random::hash(TERRAIN_SEED, x_d, z_d);
+	//Setup HeightMap
+	this->setupHeightMap(height_map, N_SMOOTH, N_RANGE);
+	//Load the texture and setup VAO, VBO for the terrains.
+	this->setupTerrain(terrain_0, terrain_1, terrain_2, terrain_3, blend_map);
+	this->flush();
+}
+
+/* Procedurally generated Terrain without any GL resources. Only touches CPU data so tiles can be built in parallel, setupTerrain uploads it afterwards. */
+Terrain::Terrain(int x_d, int z_d, const char* height_map)
+{
+	//Setup the terrain.
+	this->x = x_d * SIZE;
+	this->z = z_d * SIZE;
+	this->draw_mode = DRAW_SHADED;
+	this->terrain_top = nullptr;
+	this->terrain_bottom = nullptr;
+	this->terrain_left = nullptr;
+	this->terrain_right = nullptr;
+	this->cooked = nullptr;
+	this->VAO = 0;
+	this->VBO = 0;
+	this->grid = nullptr;
+	//Setup toWorld so that the terrain is at the center of the world.
+	this->toWorld = glm::mat4(1.0f);
+	glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->x, 0, this->z));
+	this->toWorld = translate*this->toWorld;
+	//Seed the terrain's noise from its position so it generates the same every time.
+	this->seed = Random::hash(TERRAIN_SEED, x_d, z_d);
+	//Setup HeightMap
+	this->setupHeightMap(height_map, N_SMOOTH, N_RANGE);
+}
+
+/* Terrain from a cooked tile. Copies the heights for stitching and getHeight, the upload in setupTerrain comes straight from the mapped file. */
+Terrain::Terrain(int x_d, int z_d, TerrainCache * cooked)
+{
+	//Setup the terrain.
+	this->x = x_d * SIZE;
+	this->z = z_d * SIZE;
+	this->draw_mode = DRAW_SHADED;
+	this->terrain_top = nullptr;
+	this->terrain_bottom = nullptr;
+	this->terrain_left = nullptr;
+	this->terrain_right = nullptr;
+	this->VAO = 0;
+	this->VBO = 0;
+	this->grid = nullptr;
+	//Setup toWorld so that the terrain is at the center of the world.
+	this->toWorld = glm::mat4(1.0f);
+	glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->x, 0, this->z));
+	this->toWorld = translate*this->toWorld;
+	this->seed = Random::hash(TERRAIN_SEED, x_d, z_d);
+	//Copy the heights out of the cooked tile.
+	this->cooked = cooked;
+	heights.resize(VERTEX_COUNT * VERTEX_COUNT);
+	for (int i = 0; i < (int)heights.size(); i++)
+	{
+		heights[i] = cooked->vertices[i].height;
+	}
+	saveSourceEdges(0, 0, VERTEX_COUNT, VERTEX_COUNT);
+	this->max_height = cooked->max_height;
+	this->min_height = cooked->min_height;
+	quadtree.build(&heights[0], VERTEX_COUNT, (float)SIZE / (float)(VERTEX_COUNT - 1));
+}
+
+/* Deconstructor to safely delete when finished. */
+Terrain::~Terrain()
+{
+	//Only the heights are ours, the grid is shared.
+	delete(cooked);
+	if (grid == nullptr)
+		return;
 	glDeleteVertexArrays(1, &VAO);
 	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
-}
-
-/* Setup a default flat terrain. */
-void Terrain::setupHeightMap()
-{
-	//Create the height map: v, vn, texCoords
-	//Generate vertices, normals, and texCoords for a terrain map. vertex = (j, i).
-	for (int i = 0; i < VERTEX_COUNT; i++)
-	{
-		for (int j = 0; j < VERTEX_COUNT; j++)
-		{
-			//Setup the vertices.
-			float vertex_x = (float)j / ((float)VERTEX_COUNT - 1) * SIZE;
-			float vertex_y = 0.0f;
-			float vertex_z = (float)i / ((float)VERTEX_COUNT - 1) * SIZE;
-			//Setup the normals.
-			float normal_x = 0;
-			float normal_y = 1.0f;
-			float normal_z = 0;
-			//Setup the texcoords.
-			float texCoord_x = (float)j / ((float)VERTEX_COUNT - 1);
-			float texCoord_y = (float)i / ((float)VERTEX_COUNT - 1);
-			//Push back to vectors.
-			vertices.push_back(glm::vec3(vertex_x, vertex_y, vertex_z));
-			normals.push_back(glm::vec3(normal_x, normal_y, normal_z));
-			texCoords.push_back(glm::vec2(texCoord_x, texCoord_y));
-		}
-	}
-	//Setup the indices to draw based on indice points.
-	for (int gz = 0; gz < VERTEX_COUNT - 1; gz++)
-	{
-		for (int gx = 0; gx < VERTEX_COUNT - 1; gx++)
-		{
-			int topLeft = (gz*VERTEX_COUNT) + gx;//0//1
-			int topRight = topLeft + 1;//1//2
-			int bottomLeft = ((gz + 1)*VERTEX_COUNT) + gx;//128//129
-			int bottomRight = bottomLeft + 1;//129//130
-			//Push back to indices.
-			indices.push_back(topLeft);
-			indices.push_back(bottomLeft);
-			indices.push_back(topRight);
-			indices.push_back(topRight);
-			indices.push_back(bottomLeft);
-			indices.push_back(bottomRight);
-		}
-	}
-	//Add into container structs for rendering.
-	for (int i = 0; i < VERTEX_COUNT * VERTEX_COUNT; i++)
-	{
-		//Throw everything into a container to hold all values.
-		Container container;
-		container.vertex = vertices[i];
-		container.normal = normals[i];
-		container.texCoord = texCoords[i];
-		containers.push_back(container);
-	}
-}
-
-/* Setup the terrain based on loaded height map. */
-void Terrain::setupHeightMap(const char* filename, float n_smooth, float n_range)
-{
-	//Define variables to hold height map's width, height, pixel information.
-	int width, height;
-	unsigned char * image;
-	//Generate the texture.
-	image = loadPPM(filename, width, height);//Load the ppm file.
-	//Create the height map: v, vn, texCoords
-	//Generate vertices, normals, and texCoords for a terrain map.
-	for (int i = 0; i < VERTEX_COUNT; i++)
-	{
-		for (int j = 0; j < VERTEX_COUNT; j++)
-		{
-			//Setup the vertices.
-			float vertex_x = (float)j / ((float)VERTEX_COUNT - 1) * SIZE;
-			float vertex_y = getHeightFromMap(j, i, image, width, height);
-			float vertex_z = (float)i / ((float)VERTEX_COUNT - 1) * SIZE;
-			//Setup the normals.
-			float normal_x = 0;
-			float normal_y = 1.0f;
-			float normal_z = 0;
-			//Setup the texcoords.
-			float texCoord_x = (float)j / ((float)VERTEX_COUNT - 1);
-			float texCoord_y = (float)i / ((float)VERTEX_COUNT - 1);
-			//Push back to vectors.
-			vertices.push_back(glm::vec3(vertex_x, vertex_y, vertex_z));
-			normals.push_back(glm::vec3(normal_x, normal_y, normal_z));
-			texCoords.push_back(glm::vec2(texCoord_x, texCoord_y));
-		}
-	}
-	//Setup the indices to draw based on indice points.
-	for (int gz = 0; gz < VERTEX_COUNT - 1; gz++)
-	{
-		for (int gx = 0; gx < VERTEX_COUNT - 1; gx++)
-		{
-			int topLeft = (gz*VERTEX_COUNT) + gx;
-			int topRight = topLeft + 1;
-			int bottomLeft = ((gz + 1)*VERTEX_COUNT) + gx;
-			int bottomRight = bottomLeft + 1;
-			//Push back to indices.
-			indices.push_back(topLeft);
-			indices.push_back(bottomLeft);
-			indices.push_back(topRight);
-			indices.push_back(topRight);
-			indices.push_back(bottomLeft);
-			indices.push_back(bottomRight);
-		}
-	}
-	//Add into container structs for rendering.
-	for (int i = 0; i < VERTEX_COUNT * VERTEX_COUNT; i++)
-	{
-		//Throw everything into a container to hold all values.
-		Container container;
-		container.vertex = vertices[i];
-		container.normal = normals[i];
-		container.texCoord = texCoords[i];
-		containers.push_back(container);
-	}
-	//Perform smoothing.
-	diamond_square(0, VERTEX_COUNT-1, 0, VERTEX_COUNT-1, (int)glm::pow(2, n_smooth), (float)n_range);
-	//Update normals and calculate max/min height.
-	updateNormals();
-	updateMaxMinHeight();
-}
-
-/* Returns the RGB value of the position (height). */
-float Terrain::getHeightFromMap(int x, int y, unsigned char * image, int width, int height)
-{
-	if (x < 0 || (3*x) >= (width) || y < 0 || y >= (height))
-	{
-		return 0;
-	}
-	int index = (3*x) + (width*y);
-	float value = (float)image[index]+(float)image[index + 1]+(float)image[index + 2];
-	float result = (float)fmod(value, (float)MAX_HEIGHT);
-	return result;
-}
-
-/* Return the height at a given x, y coordinate. */
-float Terrain::getHeightFromVertex(int x, int y)
-{
-	if (x < 0 || (x) >= VERTEX_COUNT || y < 0 || y >= VERTEX_COUNT)
-	{
-		return 0;
-	}
-	return this->vertices[(y*VERTEX_COUNT) + x].y;
-}
-
-/* Perform the diamond square algorithm at most 2^n steps. Pass in input level: 2^n, and small number for the range. */
-void Terrain::diamond_square(int x1, int x2, int y1, int y2, int level, float range)
-{
-	//Check base case to stop recursion.
-	if (level < 1)
-		return;
-	//Start random number generation.
-	srand((unsigned int)time(NULL));
-	//Diamond Algorithm
-	for (int i = x1 + level; i < x2; i += level)
-	{
-		for (int j = y1 + level; j < y2; j += level)
-		{
-			//Get the 4 main vertices.
-			glm::vec3 vec_a = this->vertices[(j - level)*VERTEX_COUNT + (i - level)];
-			glm::vec3 vec_b = this->vertices[(j - level)*VERTEX_COUNT + i];
-			glm::vec3 vec_c = this->vertices[(j)*VERTEX_COUNT + (i - level)];
-			glm::vec3 vec_d = this->vertices[(j)*VERTEX_COUNT + i];
-			//Get the middle vertex.
-			glm::vec3 vec_e = this->vertices[(j - level / 2)*VERTEX_COUNT + (i - level / 2)];
-			//Get the 4 heights.
-			float height_a = vec_a.y;
-			float height_b = vec_b.y;
-			float height_c = vec_c.y;
-			float height_d = vec_d.y;
-			//Calculate the average height in the middle and set it to E.
-			float height_e = (float)(height_a + height_b + height_c + height_d) / 4;
-			height_e += fmod(((float)(rand()) / 1000), MAX_DISPLACEMENT)*range;
-			vec_e.y = height_e;
-			this->vertices[(j - level / 2)*VERTEX_COUNT + (i - level / 2)] = vec_e;
-			this->containers[(j - level / 2)*VERTEX_COUNT + (i - level / 2)].vertex = vec_e;
-		}
-	}
-	//Square algorithm
-	for (int i = x1 + 2 * level; i < x2; i += level)
-	{
-		for (int j = y1 + 2 * level; j < y2; j += level)
-		{
-			//Get the 4 main vertices.
-			glm::vec3 vec_a = this->vertices[(j - level)*VERTEX_COUNT + (i - level)];
-			glm::vec3 vec_b = this->vertices[(j - level)*VERTEX_COUNT + i];
-			glm::vec3 vec_c = this->vertices[(j)*VERTEX_COUNT + (i - level)];
-			glm::vec3 vec_d = this->vertices[(j)*VERTEX_COUNT + i];
-			//Get the middle vertex.
-			glm::vec3 vec_e = this->vertices[(j - level / 2)*VERTEX_COUNT + (i - level / 2)];
-			//Get the 5 heights.
-			float height_a = vec_a.y;
-			float height_b = vec_b.y;
-			float height_c = vec_c.y;
-			float height_d = vec_d.y;
-			float height_e = vec_e.y;
-			//Calculate the average height and set it to F.
-			glm::vec3 vec_f = this->vertices[(j - level / 2)*VERTEX_COUNT + (i - level)];//
-			float height_f = (float)(height_a + height_c + height_e + this->vertices[(j - level / 2)*VERTEX_COUNT + (i - 3 * level / 2)].y) / 3;
-			height_f += fmod(((float)(rand()) / 1000), MAX_DISPLACEMENT)*range;
-			vec_f.y = height_f;
-			this->vertices[(j - level / 2)*VERTEX_COUNT + (i - level)] = vec_f;
-			this->containers[(j - level / 2)*VERTEX_COUNT + (i - level)].vertex = vec_f;
-			//Calculate the average height and set it to G.
-			glm::vec3 vec_g = this->vertices[(j - level)*VERTEX_COUNT + (i - level / 2)];
-			float height_g = (float)(height_a + height_b + height_e + this->vertices[(j - 3 * level / 2)*VERTEX_COUNT + (i - level / 2)].y) / 3;
-			height_g += fmod(((float)(rand()) / 1000), MAX_DISPLACEMENT)*range;
-			vec_g.y = height_g;
-			this->vertices[(j - level)*VERTEX_COUNT + (i - level / 2)] = vec_g;
-			this->containers[(j - level)*VERTEX_COUNT + (i - level / 2)].vertex = vec_g;
-		}
-	}
-	//Begin Recursion.
-	diamond_square(x1, x2, y1, y2, level / 2, range / 2);
-}
-
-/* Updates the normals for the entire terrain. */
-void Terrain::updateNormals()
-{
-	for (int i = 0; i < VERTEX_COUNT; i++)
-	{
-		for (int j = 0; j < VERTEX_COUNT; j++)
-		{
-			//Get the proper heights.
-			float heightL = getHeightFromVertex(j - 1, i);
-			float heightR = getHeightFromVertex(j + 1, i);
-			float heightD = getHeightFromVertex(j, i + 1);
-			float heightU = getHeightFromVertex(j, i - 1);
-			//Check if we're at the left edge.
-			if (j == 0 && (terrain_left != nullptr)) {
-				heightL = terrain_left->getHeightFromVertex((VERTEX_COUNT - 1), i);
-			}
-			//Check if we're at the right edge.
-			if (j == (VERTEX_COUNT - 1) && (terrain_right != nullptr)) {
-				heightR = terrain_right->getHeightFromVertex(0, i);
-			}
-			//Check if we're at the top edge.
-			if (i == 0  && (terrain_top != nullptr)) {
-				heightU = terrain_top->getHeightFromVertex(j, VERTEX_COUNT-1);
-			}
-			//Check if we're at the bottom edge.
-			if (i == (VERTEX_COUNT - 1) && (terrain_bottom != nullptr)) {
-				heightD = terrain_bottom->getHeightFromVertex(j, 0);
-			}
-			//Update the normal.
-			glm::vec3 normal = glm::normalize(glm::vec3(heightL - heightR, 2.0f, heightU - heightD));
-			this->normals[(i*VERTEX_COUNT) + j] = normal;
-			this->containers[(i*VERTEX_COUNT) + j].normal = normal;
-		}
-	}
-}
-
-/* Updates and finds the max and min height of the terrain. */
-void Terrain::updateMaxMinHeight()
-{
-	float max = -INFINITY, min = INFINITY;
-	for (int i = 0; i < vertices.size(); i++)
-	{
-		float cur_height = vertices[i].y;
-		if (cur_height > max)
-		{
-			max = cur_height;
-		}
-		if (cur_height < min)
-		{
-			min = cur_height;
-		}
-	}
-	//Set the max and min heights found.
-	this->max_height = max;
-	this->min_height = min;
-}
-
-/** Load a ppm file from disk.
-@input filename The location of the PPM file.  If the file is not found, an error message
-will be printed and this function will return 0
-@input width This will be modified to contain the width of the loaded image, or 0 if file not found
-@input height This will be modified to contain the height of the loaded image, or 0 if file not found
-@return Returns the RGB pixel data as interleaved unsigned chars (R0 G0 B0 R1 G1 B1 R2 G2 B2 .... etc) or 0 if an error ocured
-**/
-unsigned char * Terrain::loadPPM(const char* filename, int& width, int& height)
-{
-	const int BUFSIZE = 128;
-	FILE* fp;
-	unsigned int read;
-	unsigned char* rawData;
-	char buf[3][BUFSIZE];
-	char* retval_fgets;
-	size_t retval_sscanf;
-	//Read in the ppm file.
-	if ((fp = fopen(filename, "rb")) == NULL)
-	{
-		std::cerr << "error reading ppm file, could not locate " << filename << std::endl;
-		width = 0;
-		height = 0;
-		return NULL;
-	}
-	//Read magic number:
-	retval_fgets = fgets(buf[0], BUFSIZE, fp);
-	//Read width and height:
-	do
-	{
-		retval_fgets = fgets(buf[0], BUFSIZE, fp);
-	} while (buf[0][0] == '#');
-	retval_sscanf = sscanf(buf[0], "%s %s", buf[1], buf[2]);
-	width = atoi(buf[1]);
-	height = atoi(buf[2]);
-	//Read maxval:
-	do
-	{
-		retval_fgets = fgets(buf[0], BUFSIZE, fp);
-	} while (buf[0][0] == '#');
-	//Read image data:
-	rawData = new unsigned char[width * height * 3];
-	read = (unsigned int)fread(rawData, width * height * 3, 1, fp);
-	fclose(fp);
-	if (read != 1)
-	{
-		std::cerr << "error parsing ppm file, incomplete data" << std::endl;
-		delete[] rawData;
-		width = 0;
-		height = 0;
-		return NULL;
-	}
-	return rawData;//Return rawData or 0 if failed.
-}
-
-/* Load the Terrain through the read height map. */
-GLuint Terrain::loadTerrain(const char* filename, int index)
-{
-	//Hold the textureID (This will be the textureID to return).
-	GLuint textureID;
-	//Define variables to hold height map's width, height, pixel information.
-	int width, height;
-	unsigned char * image;
-	//Create ID for texture.
-	glGenTextures(1, &textureID);
-	//Set the active texture ID.
-	glActiveTexture(GL_TEXTURE0);
-	//Set this texture to be the one we are working with.
-	glBindTexture(GL_TEXTURE_2D, textureID);
-	//Generate the texture.
-	image = loadPPM(filename, width, height);//Load the ppm file.
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-	//Make sure no bytes are padded:
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-	//Use bilinear interpolation:
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	//Use clamp to edge:
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);//X
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);//Y
-	//Unbind the texture cube map.
-	glBindTexture(GL_TEXTURE_2D, 0);
-	//Return the textureID, we need to keep track of this texture variable.
-	return textureID;
-}
-
-/* Initialize a terrain based on height maps. We can choose to generate a default height map or read in from an image ".ppm" file. */
-void Terrain::setupTerrain(const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map)
-{
-	//Create buffers/arrays.
-	glGenVertexArrays(1, &this->VAO);
-	glGenBuffers(1, &this->VBO);
-	glGenBuffers(1, &this->EBO);
-
-	//Bind the Vertex Array Object first, then bind and set vertex buffer(s) and attribute pointer(s).
-	glBindVertexArray(VAO); //Bind vertex array object.
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO); //Bind Container buffer.
-	glBufferData(GL_ARRAY_BUFFER, this->containers.size() * sizeof(Container), &this->containers[0], GL_STATIC_DRAW); //Set vertex buffer to the Container.
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO); //Bind indices buffer.
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(int), &this->indices[0], GL_STATIC_DRAW);
-
-	//Vertex Positions.
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0,//This first parameter x should be the same as the number passed into the line "layout (location = x)" in the vertex shader. In this case, it's 0. Valid values are 0 to GL_MAX_UNIFORM_LOCATIONS.
-		3, //This second line tells us how any components there are per vertex. In this case, it's 3 (we have an x, y, and z component).
-		GL_FLOAT, //What type these components are.
-		GL_FALSE, //GL_TRUE means the values should be normalized. GL_FALSE means they shouldn't.
-		sizeof(Container), //Offset between consecutive vertex attributes. Since each of our vertices have 3 floats, they should have the size of 3 floats in between.
-		(GLvoid*)0); //Offset of the first vertex's component. In our case it's 0 since we don't pad the vertices array with anything.
-
-	//Vertex Normals.
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Container), (GLvoid*)offsetof(Container, normal));
-
-	//Vertex Texture Coords.
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Container), (GLvoid*)offsetof(Container, texCoord));
-
-	//Set up Terrain textures.
-	this->terrainTexture_0 = loadTerrain(terrain_0, 0);
-	this->terrainTexture_1 = loadTerrain(terrain_1, 0);
-	this->terrainTexture_2 = loadTerrain(terrain_2, 0);
-	this->terrainTexture_3 = loadTerrain(terrain_3, 0);
-	this->blendMap = loadTerrain(blend_map, 4);
-
-	//Unbind.
-	glBindBuffer(GL_ARRAY_BUFFER, 0); //Note that this is allowed, the call to glVertexAttribPointer registered VBO as the currently bound vertex buffer object so afterwards we can safely unbind.
-	glBindVertexArray(0); //Unbind VAO (it's always a good thing to unbind any buffer/array to prevent strange bugs), remember: do NOT unbind the EBO, keep it bound to this VAO.
-}
-
-/* Toggle the draw mode to draw the mesh as lines (wireframe) or as triangle faces. */
-void Terrain::toggleDrawMode()
-{
-	if (draw_mode == 0)
-	{
-		draw_mode = DRAW_WIREFRAME;
-	}
-	else
-	{
-		draw_mode = DRAW_SHADED;
-	}
-}
-
-/* Draw the terrain. */
+	TerrainGrid::release();
+	//The textures are shared through the cache.
+	TextureCache::release(terrainTexture_0);
+	TextureCache::release(terrainTexture_1);
+	TextureCache::release(terrainTexture_2);
+	TextureCache::release(terrainTexture_3);
+	TextureCache::release(blendMap);
+}
+
+/* Setup a default flat terrain. */
+void Terrain::setupHeightMap()
+{
+	//Create the height map. The xz positions and texCoords come from the vertex ID, the normals from the heights.
+	heights.assign(VERTEX_COUNT * VERTEX_COUNT, 0.0f);
+	saveSourceEdges(0, 0, VERTEX_COUNT, VERTEX_COUNT);
+	updateMaxMinHeight();
+}
+
+/* Setup the terrain based on loaded height map. */
+void Terrain::setupHeightMap(const char* filename, float n_smooth, float n_range)
+{
+	//Define variables to hold height map's width, height, pixel information.
+	int width, height;
+	unsigned char * image;
+	//Generate the texture.
+	image = loadPPM(filename, width, height);//Load the ppm file.
+	//Create the height map, vertex = (j, i). The xz positions and texCoords come from the vertex ID, the normals from the heights.
+	heights.resize(VERTEX_COUNT * VERTEX_COUNT);
+	for (int i = 0; i < VERTEX_COUNT; i++)
+	{
+		for (int j = 0; j < VERTEX_COUNT; j++)
+		{
+			heights[(i*VERTEX_COUNT) + j] = getHeightFromMap(j, i, image, width, height);
+		}
+	}
+	//The height map is no longer needed.
+	delete[] image;
+	//Perform smoothing.
+	diamond_square(0, VERTEX_COUNT-1, 0, VERTEX_COUNT-1, (int)glm::pow(2, n_smooth), (float)n_range);
+	saveSourceEdges(0, 0, VERTEX_COUNT, VERTEX_COUNT);
+	//Calculate max/min height.
+	updateMaxMinHeight();
+}
+
+/* Return the key a tile at (x_d, z_d) from a source height map with the given hash is cooked under. Changing any generation parameter changes every key. */
+unsigned long long Terrain::getCookKey(int x_d, int z_d, unsigned long long source)
+{
+	float parameters[] = { (float)VERTEX_COUNT, (float)SIZE, (float)MAX_HEIGHT, MAX_DISPLACEMENT, N_SMOOTH, N_RANGE };
+	unsigned int tile[] = { TERRAIN_SEED, (unsigned int)x_d, (unsigned int)z_d };
+	unsigned long long key = TerrainCache::hash(0, parameters, sizeof(parameters));
+	key = TerrainCache::hash(key, tile, sizeof(tile));
+	return TerrainCache::hash(key, &source, sizeof(source));
+}
+
+/* Map a cooked tile of this terrain size, nullptr if it needs cooking. */
+TerrainCache * Terrain::openCooked(const std::string &filename, unsigned long long key)
+{
+	return TerrainCache::open(filename, key, VERTEX_COUNT);
+}
+
+/* Write the current heights, normals and max/min height as a cooked tile. */
+bool Terrain::cook(const std::string &filename, unsigned long long key)
+{
+	std::vector<TerrainVertex> terrainVertices(heights.size());
+	packVertices(0, (int)heights.size(), &terrainVertices[0]);
+	return TerrainCache::write(filename, key, terrainVertices, this->min_height, this->max_height);
+}
+
+/* Returns the RGB value of the position (height). */
+float Terrain::getHeightFromMap(int x, int y, unsigned char * image, int width, int height)
+{
+	if (x < 0 || (3*x) >= (width) || y < 0 || y >= (height))
+	{
+		return 0;
+	}
+	int index = (3*x) + (width*y);
+	float value = (float)image[index]+(float)image[index + 1]+(float)image[index + 2];
+	float result = (float)fmod(value, (float)MAX_HEIGHT);
+	return result;
+}
+
+/* Return the height at a given x, y coordinate. */
+float Terrain::getHeightFromVertex(int x, int y)
+{
+	if (x < 0 || (x) >= VERTEX_COUNT || y < 0 || y >= VERTEX_COUNT)
+	{
+		return 0;
+	}
+	return this->heights[(y*VERTEX_COUNT) + x];
+}
+
+/* Perform the diamond square algorithm at most 2^n steps. Pass in input level: 2^n, and small number for the range. Runs level by level, row by row over the height array, with noise from the terrain's own seeded generator so the result is reproducible. */
+void Terrain::diamond_square(int x1, int x2, int y1, int y2, int level, float range)
+{
+	//Seeded from the terrain's position, nothing is shared with other terrains.
+	Random random(this->seed);
+	//Noise for one row, drawn before the row is processed so the inner loops are only arithmetic. The square step keeps F's noise in the first half and G's in the second.
+	std::vector<float> noise(2 * VERTEX_COUNT);
+	//Each row's strided samples gathered side by side, so the averaging runs over unit stride and the compiler can vectorize it. Results go to out before being scattered back.
+	std::vector<float> top(VERTEX_COUNT), bottom(VERTEX_COUNT), middle(VERTEX_COUNT), above(VERTEX_COUNT), out(2 * VERTEX_COUNT);
+	float * h = &this->heights[0];
+	for (; level >= 1; level /= 2, range /= 2)
+	{
+		int half = level / 2;
+		//Diamond Algorithm
+		for (int j = y1 + level; j < y2; j += level)
+		{
+			int count = 0;
+			for (int i = x1 + level; i < x2; i += level)
+			{
+				noise[count++] = random.nextFloat() * MAX_DISPLACEMENT * range;
+			}
+			//The 4 main vertices are on rows a (top) and c (bottom), the middle vertex E is on row e.
+			const float * row_a = h + (j - level) * VERTEX_COUNT;
+			const float * row_c = h + j * VERTEX_COUNT;
+			float * row_e = h + (j - half) * VERTEX_COUNT;
+			if (half == 0)
+			{
+				//At the last level row e is row c and each E is read back as the next one's corner, a recurrence that has to stay in order.
+				count = 0;
+				for (int i = x1 + level; i < x2; i += level)
+				{
+					row_e[i - half] = (row_a[i - level] + row_a[i] + row_c[i - level] + row_c[i]) / 4 + noise[count++];
+				}
+				continue;
+			}
+			//Rows a, c and e are all different, so the E's don't depend on each other.
+			for (int k = 0; k <= count; k++)
+			{
+				top[k] = row_a[x1 + k * level];
+				bottom[k] = row_c[x1 + k * level];
+			}
+			const float * a = &top[0];
+			const float * c = &bottom[0];
+			const float * n = &noise[0];
+			float * e = &out[0];
+			for (int k = 0; k < count; k++)
+			{
+				//Calculate the average height in the middle and set it to E.
+				e[k] = (a[k] + a[k + 1] + c[k] + c[k + 1]) / 4 + n[k];
+			}
+			for (int k = 0; k < count; k++)
+			{
+				row_e[x1 + (k + 1) * level - half] = e[k];
+			}
+		}
+		//Square algorithm
+		for (int j = y1 + 2 * level; j < y2; j += level)
+		{
+			int count = 0;
+			for (int i = x1 + 2 * level; i < x2; i += level)
+			{
+				noise[count] = random.nextFloat() * MAX_DISPLACEMENT * range;
+				noise[VERTEX_COUNT + count] = random.nextFloat() * MAX_DISPLACEMENT * range;
+				count++;
+			}
+			//F is on the middle row e, G is on the top row a and also takes the middle of the row above (row g).
+			float * row_a = h + (j - level) * VERTEX_COUNT;
+			const float * row_c = h + j * VERTEX_COUNT;
+			float * row_e = h + (j - half) * VERTEX_COUNT;
+			const float * row_g = h + (j - 3 * level / 2) * VERTEX_COUNT;
+			if (half == 0)
+			{
+				//At the last level row g is row a and each G is read back as the next one's A, a recurrence that has to stay in order.
+				count = 0;
+				for (int i = x1 + 2 * level; i < x2; i += level)
+				{
+					//Get the 4 heights.
+					float height_a = row_a[i - level];
+					float height_b = row_a[i];
+					float height_c = row_c[i - level];
+					float height_e = row_e[i - half];
+					//Calculate the average height and set it to F.
+					row_e[i - level] = (height_a + height_c + height_e + row_e[i - 3 * level / 2]) / 3 + noise[count];
+					//Calculate the average height and set it to G.
+					row_a[i - half] = (height_a + height_b + height_e + row_g[i - half]) / 3 + noise[VERTEX_COUNT + count];
+					count++;
+				}
+				continue;
+			}
+			//F and G are written on the half steps and read only on the whole ones, or the other way round, so gathering first reads the same heights.
+			for (int k = 0; k <= count; k++)
+			{
+				top[k] = row_a[x1 + (k + 1) * level];
+				bottom[k] = row_c[x1 + (k + 1) * level];
+				middle[k] = row_e[x1 + (k + 1) * level - half];
+			}
+			for (int k = 0; k < count; k++)
+			{
+				above[k] = row_g[x1 + (k + 2) * level - half];
+			}
+			const float * a = &top[0];
+			const float * c = &bottom[0];
+			const float * e = &middle[0];
+			const float * g = &above[0];
+			const float * n = &noise[0];
+			float * f = &out[0];
+			float * b = &out[VERTEX_COUNT];
+			for (int k = 0; k < count; k++)
+			{
+				//Calculate the average height and set it to F, then G.
+				f[k] = (a[k] + c[k] + e[k + 1] + e[k]) / 3 + n[k];
+				b[k] = (a[k] + a[k + 1] + e[k + 1] + g[k]) / 3 + n[VERTEX_COUNT + k];
+			}
+			for (int k = 0; k < count; k++)
+			{
+				row_e[x1 + (k + 1) * level] = f[k];
+				row_a[x1 + (k + 2) * level - half] = b[k];
+			}
+		}
+	}
+}
+
+/* Updates the normals for the entire terrain. Normals aren't stored, they're worked out from the heights as vertices are packed, so this just marks everything for the next flush. */
+void Terrain::updateNormals()
+{
+	markDirty(0, VERTEX_COUNT * VERTEX_COUNT);
+}
+
+/* Return the normal at vertex (j, i) from the heights around it, using the neighbours' heights at the edges. */
+glm::vec3 Terrain::getNormal(int j, int i)
+{
+	//Get the proper heights.
+	float heightL = getHeightFromVertex(j - 1, i);
+	float heightR = getHeightFromVertex(j + 1, i);
+	float heightD = getHeightFromVertex(j, i + 1);
+	float heightU = getHeightFromVertex(j, i - 1);
+	//Check if we're at the left edge.
+	if (j == 0 && (terrain_left != nullptr)) {
+		heightL = terrain_left->getHeightFromVertex((VERTEX_COUNT - 1), i);
+	}
+	//Check if we're at the right edge.
+	if (j == (VERTEX_COUNT - 1) && (terrain_right != nullptr)) {
+		heightR = terrain_right->getHeightFromVertex(0, i);
+	}
+	//Check if we're at the top edge.
+	if (i == 0  && (terrain_top != nullptr)) {
+		heightU = terrain_top->getHeightFromVertex(j, VERTEX_COUNT-1);
+	}
+	//Check if we're at the bottom edge.
+	if (i == (VERTEX_COUNT - 1) && (terrain_bottom != nullptr)) {
+		heightD = terrain_bottom->getHeightFromVertex(j, 0);
+	}
+	return glm::normalize(glm::vec3(heightL - heightR, 2.0f, heightU - heightD));
+}
+
+/* Pack a normal as signed 10:10:10:2, w is left at 0. */
+GLuint Terrain::packNormal(glm::vec3 normal)
+{
+	GLuint packed = 0;
+	for (int c = 0; c < 3; c++)
+	{
+		int value = (int)floor(glm::clamp(normal[c], -1.0f, 1.0f) * 511.0f + 0.5f);
+		packed |= ((GLuint)value & 0x3FF) << (10 * c);
+	}
+	return packed;
+}
+
+/* Pack vertices [begin, end) for upload: the height and the normal as signed 10:10:10:2. Works row by row, the inside of each row only reads the rows above and below so it runs four vertices at a time, the border vertices go through getNormal for the neighbours' heights. */
+void Terrain::packVertices(int begin, int end, TerrainVertex * out)
+{
+	const float * h = &this->heights[0];
+	int index = begin;
+	while (index < end)
+	{
+		int i = index / VERTEX_COUNT;
+		int row_end = glm::min(end, (i + 1) * VERTEX_COUNT);
+		if (i > 0 && i < VERTEX_COUNT - 1)
+		{
+			//Left border.
+			if (index == i * VERTEX_COUNT)
+			{
+				out[index - begin].height = h[index];
+				out[index - begin].normal = packNormal(getNormal(0, i));
+				index++;
+			}
+			int inside_end = glm::min(row_end, (i + 1) * VERTEX_COUNT - 1);
+#ifdef TERRAIN_SSE
+			__m128 two = _mm_set1_ps(2.0f);
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 scale = _mm_set1_ps(511.0f);
+			__m128 half = _mm_set1_ps(0.5f);
+			__m128i ten_bits = _mm_set1_epi32(0x3FF);
+			for (; index + 4 <= inside_end; index += 4)
+			{
+				//Same as getNormal: (L - R, 2, U - D), normalized.
+				__m128 normal_x = _mm_sub_ps(_mm_loadu_ps(h + index - 1), _mm_loadu_ps(h + index + 1));
+				__m128 normal_z = _mm_sub_ps(_mm_loadu_ps(h + index - VERTEX_COUNT), _mm_loadu_ps(h + index + VERTEX_COUNT));
+				__m128 length = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normal_x, normal_x), _mm_mul_ps(normal_z, normal_z)), _mm_mul_ps(two, two));
+				__m128 inverse = _mm_div_ps(one, _mm_sqrt_ps(length));
+				//Scale to 10 bits with floor(n * 511 + 0.5) like packNormal, truncation rounds negatives up so those step back down.
+				__m128 scaled[3] = {
+					_mm_add_ps(_mm_mul_ps(_mm_mul_ps(normal_x, inverse), scale), half),
+					_mm_add_ps(_mm_mul_ps(_mm_mul_ps(two, inverse), scale), half),
+					_mm_add_ps(_mm_mul_ps(_mm_mul_ps(normal_z, inverse), scale), half) };
+				__m128i rounded[3];
+				for (int c = 0; c < 3; c++)
+				{
+					__m128i truncated = _mm_cvttps_epi32(scaled[c]);
+					rounded[c] = _mm_add_epi32(truncated, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(truncated), scaled[c])));
+				}
+				__m128i x = rounded[0], y = rounded[1], z = rounded[2];
+				__m128i packed = _mm_or_si128(_mm_and_si128(x, ten_bits), _mm_or_si128(_mm_slli_epi32(_mm_and_si128(y, ten_bits), 10), _mm_slli_epi32(_mm_and_si128(z, ten_bits), 20)));
+				//Interleave [height, normal] for the four vertices.
+				__m128 height = _mm_loadu_ps(h + index);
+				__m128 normal = _mm_castsi128_ps(packed);
+				_mm_storeu_ps((float *)&out[index - begin], _mm_unpacklo_ps(height, normal));
+				_mm_storeu_ps((float *)&out[index - begin + 2], _mm_unpackhi_ps(height, normal));
+			}
+#endif
+			for (; index < inside_end; index++)
+			{
+				out[index - begin].height = h[index];
+				out[index - begin].normal = packNormal(getNormal(index % VERTEX_COUNT, i));
+			}
+		}
+		//Right border, or all of the top and bottom rows.
+		for (; index < row_end; index++)
+		{
+			out[index - begin].height = h[index];
+			out[index - begin].normal = packNormal(getNormal(index % VERTEX_COUNT, i));
+		}
+	}
+}
+
+/* Mark the vertices in [x0, x1) x [z0, z1) whose heights changed. Normals depend on the heights either side, so the rectangle grows by one vertex, and a neighbour's edge is marked too when its normals read the heights along our border. */
+void Terrain::markDirtyRect(int x0, int z0, int x1, int z1)
+{
+	//Refit the quadtree over the changed heights, stitching can move an edge past the old max/min.
+	quadtree.update(&heights[0], x0, z0, x1, z1);
+	glm::vec2 range = quadtree.getRange();
+	this->min_height = range.x;
+	this->max_height = range.y;
+	int left = glm::max(x0 - 1, 0);
+	int right = glm::min(x1 + 1, VERTEX_COUNT);
+	int top = glm::max(z0 - 1, 0);
+	int bottom = glm::min(z1 + 1, VERTEX_COUNT);
+	for (int i = top; i < bottom; i++)
+	{
+		markDirty(i * VERTEX_COUNT + left, i * VERTEX_COUNT + right);
+	}
+	//The neighbours' edge vertices read across into our first and last rows and columns.
+	if (x0 == 0 && terrain_left != nullptr)
+	{
+		for (int i = z0; i < z1; i++)
+			terrain_left->markDirty(i * VERTEX_COUNT + VERTEX_COUNT - 1, i * VERTEX_COUNT + VERTEX_COUNT);
+	}
+	if (x1 == VERTEX_COUNT && terrain_right != nullptr)
+	{
+		for (int i = z0; i < z1; i++)
+			terrain_right->markDirty(i * VERTEX_COUNT, i * VERTEX_COUNT + 1);
+	}
+	if (z0 == 0 && terrain_top != nullptr)
+	{
+		terrain_top->markDirty((VERTEX_COUNT - 1) * VERTEX_COUNT + x0, (VERTEX_COUNT - 1) * VERTEX_COUNT + x1);
+	}
+	if (z1 == VERTEX_COUNT && terrain_bottom != nullptr)
+	{
+		terrain_bottom->markDirty(x0, x1);
+	}
+}
+
+/* Return the height at vertex (j, i), one vertex past the edges reads the neighbour's vertex next to the shared edge. Further out, or with no neighbour, it clamps. */
+float Terrain::getSharedHeight(int j, int i)
+{
+	if (j < 0 && terrain_left != nullptr && i >= 0 && i < VERTEX_COUNT)
+		return terrain_left->heights[i * VERTEX_COUNT + VERTEX_COUNT - 2];
+	if (j >= VERTEX_COUNT && terrain_right != nullptr && i >= 0 && i < VERTEX_COUNT)
+		return terrain_right->heights[i * VERTEX_COUNT + 1];
+	if (i < 0 && terrain_top != nullptr && j >= 0 && j < VERTEX_COUNT)
+		return terrain_top->heights[(VERTEX_COUNT - 2) * VERTEX_COUNT + j];
+	if (i >= VERTEX_COUNT && terrain_bottom != nullptr && j >= 0 && j < VERTEX_COUNT)
+		return terrain_bottom->heights[VERTEX_COUNT + j];
+	j = glm::clamp(j, 0, VERTEX_COUNT - 1);
+	i = glm::clamp(i, 0, VERTEX_COUNT - 1);
+	return heights[i * VERTEX_COUNT + j];
+}
+
+/* Work out the new heights under the brush without changing anything yet. Distances are taken in world space so the vertices on a shared edge get exactly the same result on both terrains. */
+void Terrain::sculpt(const Brush &brush)
+{
+	float gridSize = (float)(SIZE) / (float)(VERTEX_COUNT - 1);
+	//The vertices inside the brush's square.
+	int x0 = glm::max((int)ceil((brush.center.x - brush.radius - this->x) / gridSize), 0);
+	int x1 = glm::min((int)floor((brush.center.x + brush.radius - this->x) / gridSize) + 1, VERTEX_COUNT);
+	int z0 = glm::max((int)ceil((brush.center.z - brush.radius - this->z) / gridSize), 0);
+	int z1 = glm::min((int)floor((brush.center.z + brush.radius - this->z) / gridSize) + 1, VERTEX_COUNT);
+	sculpt_rect = glm::ivec4(x0, z0, x1, z1);
+	sculpt_heights.clear();
+	if (x0 >= x1 || z0 >= z1)
+		return;
+	sculpt_heights.resize((x1 - x0) * (z1 - z0));
+	float radius_2 = brush.radius * brush.radius;
+	int n = 0;
+	for (int i = z0; i < z1; i++)
+	{
+		float dz = (this->z + i * gridSize) - brush.center.z;
+		const float * row = &heights[i * VERTEX_COUNT];
+		for (int j = x0; j < x1; j++, n++)
+		{
+			float dx = (this->x + j * gridSize) - brush.center.x;
+			float distance_2 = dx * dx + dz * dz;
+			float height = row[j];
+			sculpt_heights[n] = height;
+			if (distance_2 >= radius_2)
+				continue;
+			//Cosine falloff, 1 at the center and 0 at the radius.
+			float weight = 0.5f * (1.0f + cos(glm::pi<float>() * sqrt(distance_2) / brush.radius));
+			float blend = glm::min(brush.strength * weight, 1.0f);
+			switch (brush.mode)
+			{
+			case BRUSH_RAISE:
+				sculpt_heights[n] = height + brush.strength * weight;
+				break;
+			case BRUSH_LOWER:
+				sculpt_heights[n] = height - brush.strength * weight;
+				break;
+			case BRUSH_SMOOTH:
+			{
+				//Only the border vertices need the neighbours' heights.
+				float average;
+				if (j > 0 && j < VERTEX_COUNT - 1 && i > 0 && i < VERTEX_COUNT - 1)
+					average = (row[j - 1] + row[j + 1] + row[j - VERTEX_COUNT] + row[j + VERTEX_COUNT]) / 4.0f;
+				else
+					average = (getSharedHeight(j - 1, i) + getSharedHeight(j + 1, i) + getSharedHeight(j, i - 1) + getSharedHeight(j, i + 1)) / 4.0f;
+				sculpt_heights[n] = height + (average - height) * blend;
+				break;
+			}
+			case BRUSH_FLATTEN:
+				sculpt_heights[n] = height + (brush.target - height) * blend;
+				break;
+			}
+		}
+	}
+}
+
+/* Write the heights worked out by sculpt and mark them, flush uploads the rectangle in one go. */
+void Terrain::applySculpt()
+{
+	if (sculpt_heights.empty())
+		return;
+	int x0 = sculpt_rect.x, z0 = sculpt_rect.y, x1 = sculpt_rect.z, z1 = sculpt_rect.w;
+	int n = 0;
+	for (int i = z0; i < z1; i++)
+	{
+		for (int j = x0; j < x1; j++, n++)
+		{
+			heights[i * VERTEX_COUNT + j] = sculpt_heights[n];
+		}
+	}
+	sculpt_heights.clear();
+	//Sculpting gives a shared edge the same heights on both terrains, so they're kept as the new sources.
+	saveSourceEdges(x0, z0, x1, z1);
+	markDirtyRect(x0, z0, x1, z1);
+}
+
+/* Detach from the neighbours. Each one's edge facing us goes back to its own heights, which also marks it for the next flush. */
+void Terrain::unlink()
+{
+	Terrain * left = terrain_left;
+	Terrain * right = terrain_right;
+	Terrain * top = terrain_top;
+	Terrain * bottom = terrain_bottom;
+	//Every link to us goes first, so restoring a corner can't reach back here.
+	if (left != nullptr)
+		left->terrain_right = nullptr;
+	if (right != nullptr)
+		right->terrain_left = nullptr;
+	if (top != nullptr)
+		top->terrain_bottom = nullptr;
+	if (bottom != nullptr)
+		bottom->terrain_top = nullptr;
+	terrain_left = nullptr;
+	terrain_right = nullptr;
+	terrain_top = nullptr;
+	terrain_bottom = nullptr;
+	if (left != nullptr)
+		left->restoreEdge(EDGE_RIGHT);
+	if (right != nullptr)
+		right->restoreEdge(EDGE_LEFT);
+	if (top != nullptr)
+		top->restoreEdge(EDGE_BOTTOM);
+	if (bottom != nullptr)
+		bottom->restoreEdge(EDGE_TOP);
+}
+
+/* Copy the edge vertices inside [x0, x1) x [z0, z1) to the source edges. */
+void Terrain::saveSourceEdges(int x0, int z0, int x1, int z1)
+{
+	source_edges.resize(4 * VERTEX_COUNT);
+	for (int i = z0; i < z1; i++)
+	{
+		if (x0 == 0)
+			source_edges[EDGE_LEFT * VERTEX_COUNT + i] = heights[i * VERTEX_COUNT];
+		if (x1 == VERTEX_COUNT)
+			source_edges[EDGE_RIGHT * VERTEX_COUNT + i] = heights[i * VERTEX_COUNT + VERTEX_COUNT - 1];
+	}
+	for (int j = x0; j < x1; j++)
+	{
+		if (z0 == 0)
+			source_edges[EDGE_TOP * VERTEX_COUNT + j] = heights[j];
+		if (z1 == VERTEX_COUNT)
+			source_edges[EDGE_BOTTOM * VERTEX_COUNT + j] = heights[(VERTEX_COUNT - 1) * VERTEX_COUNT + j];
+	}
+}
+
+/* Return the source height of the edge vertex (j, i). */
+float Terrain::getSourceHeight(int j, int i)
+{
+	if (j == 0)
+		return source_edges[EDGE_LEFT * VERTEX_COUNT + i];
+	if (j == VERTEX_COUNT - 1)
+		return source_edges[EDGE_RIGHT * VERTEX_COUNT + i];
+	if (i == 0)
+		return source_edges[EDGE_TOP * VERTEX_COUNT + j];
+	return source_edges[EDGE_BOTTOM * VERTEX_COUNT + j];
+}
+
+/* Put one edge back to the source heights, then share its corners with whoever is still linked. */
+void Terrain::restoreEdge(int side)
+{
+	for (int k = 0; k < VERTEX_COUNT; k++)
+	{
+		int j = (side == EDGE_LEFT) ? 0 : (side == EDGE_RIGHT) ? VERTEX_COUNT - 1 : k;
+		int i = (side == EDGE_TOP) ? 0 : (side == EDGE_BOTTOM) ? VERTEX_COUNT - 1 : k;
+		heights[i * VERTEX_COUNT + j] = getSourceHeight(j, i);
+	}
+	if (side == EDGE_LEFT || side == EDGE_RIGHT)
+	{
+		int j = (side == EDGE_LEFT) ? 0 : VERTEX_COUNT - 1;
+		markDirtyRect(j, 0, j + 1, VERTEX_COUNT);
+		stitch_corner(j, 0);
+		stitch_corner(j, VERTEX_COUNT - 1);
+	}
+	else
+	{
+		int i = (side == EDGE_TOP) ? 0 : VERTEX_COUNT - 1;
+		markDirtyRect(0, i, VERTEX_COUNT, i + 1);
+		stitch_corner(0, i);
+		stitch_corner(VERTEX_COUNT - 1, i);
+	}
+}
+
+/* Updates and finds the max and min height of the terrain. */
+void Terrain::updateMaxMinHeight()
+{
+	//The root of the quadtree covers the whole terrain.
+	quadtree.build(&heights[0], VERTEX_COUNT, (float)SIZE / (float)(VERTEX_COUNT - 1));
+	glm::vec2 range = quadtree.getRange();
+	this->min_height = range.x;
+	this->max_height = range.y;
+}
+
+/** Load a ppm file from disk.
+@input filename The location of the PPM file.  If the file is not found, an error message
+will be printed and this function will return 0
+@input width This will be modified to contain the width of the loaded image, or 0 if file not found
+@input height This will be modified to contain the height of the loaded image, or 0 if file not found
+@return Returns the RGB pixel data as interleaved unsigned chars (R0 G0 B0 R1 G1 B1 R2 G2 B2 .... etc) or 0 if an error ocured
+**/
+unsigned char * Terrain::loadPPM(const char* filename, int& width, int& height)
+{
+	const int BUFSIZE = 128;
+	FILE* fp;
+	unsigned int read;
+	unsigned char* rawData;
+	char buf[3][BUFSIZE];
+	char* retval_fgets;
+	size_t retval_sscanf;
+	//Read in the ppm file.
+	if ((fp = fopen(filename, "rb")) == NULL)
+	{
+		std::cerr << "error reading ppm file, could not locate " << filename << std::endl;
+		width = 0;
+		height = 0;
+		return NULL;
+	}
+	//Read magic number:
+	retval_fgets = fgets(buf[0], BUFSIZE, fp);
+	//Read width and height:
+	do
+	{
+		retval_fgets = fgets(buf[0], BUFSIZE, fp);
+	} while (buf[0][0] == '#');
+	retval_sscanf = sscanf(buf[0], "%s %s", buf[1], buf[2]);
+	width = atoi(buf[1]);
+	height = atoi(buf[2]);
+	//Read maxval:
+	do
+	{
+		retval_fgets = fgets(buf[0], BUFSIZE, fp);
+	} while (buf[0][0] == '#');
+	//Read image data:
+	rawData = new unsigned char[width * height * 3];
+	read = (unsigned int)fread(rawData, width * height * 3, 1, fp);
+	fclose(fp);
+	if (read != 1)
+	{
+		std::cerr << "error parsing ppm file, incomplete data" << std::endl;
+		delete[] rawData;
+		width = 0;
+		height = 0;
+		return NULL;
+	}
+	return rawData;//Return rawData or 0 if failed.
+}
+
+/* Initialize a terrain based on height maps. We can choose to generate a default height map or read in from an image ".ppm" file. Call flush afterwards to upload a terrain that wasn't cooked. */
+void Terrain::setupTerrain(const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map)
+{
+	//Get the shared indices.
+	this->grid = TerrainGrid::acquire(VERTEX_COUNT, PATCH_SIZE);
+	this->patch_lods.assign(grid->patch_count * grid->patch_count, 0);
+
+	//Create buffers/arrays.
+	glGenVertexArrays(1, &this->VAO);
+	glGenBuffers(1, &this->VBO);
+
+	//Bind the Vertex Array Object first, then bind and set vertex buffer(s) and attribute pointer(s).
+	glBindVertexArray(VAO); //Bind vertex array object.
+
+	//There are no xz positions or texCoords to bind, terrain.vert works them out from gl_VertexID.
+	glBindBuffer(GL_ARRAY_BUFFER, VBO); //Bind this terrain's heights and normals.
+	if (this->cooked != nullptr)
+	{
+		//Cooked tiles are already in upload layout, send the mapped file as is.
+		glBufferData(GL_ARRAY_BUFFER, heights.size() * sizeof(TerrainVertex), this->cooked->vertices, GL_STATIC_DRAW);
+		delete(this->cooked);
+		this->cooked = nullptr;
+		dirty_spans.clear();
+	}
+	else
+	{
+		//Allocate only, the vertices are packed and uploaded by the next flush (after stitching, so only once).
+		glBufferData(GL_ARRAY_BUFFER, heights.size() * sizeof(TerrainVertex), NULL, GL_STATIC_DRAW);
+		dirty_spans.clear();
+		markDirty(0, (int)heights.size());
+	}
+
+	//Vertex Heights.
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0,//This first parameter x should be the same as the number passed into the line "layout (location = x)" in the vertex shader. In this case, it's 0. Valid values are 0 to GL_MAX_UNIFORM_LOCATIONS.
+		1, //This second line tells us how any components there are per vertex. In this case, it's 1 (only y, x and z come from the vertex ID).
+		GL_FLOAT, //What type these components are.
+		GL_FALSE, //GL_TRUE means the values should be normalized. GL_FALSE means they shouldn't.
+		sizeof(TerrainVertex), //Offset between consecutive vertex attributes. Each vertex is [Y] [N].
+		(GLvoid*)offsetof(TerrainVertex, height)); //Offset of the first vertex's component.
+
+	//Vertex Normals, packed signed 10:10:10:2 and normalized back to [-1, 1].
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(TerrainVertex), (GLvoid*)offsetof(TerrainVertex, normal));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, grid->EBO); //Bind the shared indices.
+
+	//Set up Terrain textures. Every tile shares the same four, only the blend map differs.
+	this->terrainTexture_0 = TextureCache::loadTexture(terrain_0);
+	this->terrainTexture_1 = TextureCache::loadTexture(terrain_1);
+	this->terrainTexture_2 = TextureCache::loadTexture(terrain_2);
+	this->terrainTexture_3 = TextureCache::loadTexture(terrain_3);
+	this->blendMap = TextureCache::loadTexture(blend_map);
+
+	//Unbind.
+	glBindBuffer(GL_ARRAY_BUFFER, 0); //Note that this is allowed, the call to glVertexAttribPointer registered VBO as the currently bound vertex buffer object so afterwards we can safely unbind.
+	glBindVertexArray(0); //Unbind VAO (it's always a good thing to unbind any buffer/array to prevent strange bugs), remember: do NOT unbind the EBO, keep it bound to this VAO.
+}
+
+/* Toggle the draw mode to draw the mesh as lines (wireframe) or as triangle faces. */
+void Terrain::toggleDrawMode()
+{
+	if (draw_mode == 0)
+	{
+		draw_mode = DRAW_WIREFRAME;
+	}
+	else
+	{
+		draw_mode = DRAW_SHADED;
+	}
+}
+
+/* Draw the terrain. */
 void Terrain::draw(GLuint shaderProgram)
-{
-	//Calculate combination of the model (toWorld), view (camera inverse), and perspective matrices. Send to shader.
-	glm::mat4 MVP = Window::P * Window::V * this->toWorld;
-	glm::mat4 model = this->toWorld;//We don't really need this, but we'll pass it through just in case.
-	glm::mat4 view = glm::mat4(glm::mat3(Window::V));//Remove translation from the view matrix.
-	glm::mat4 projection = Window::P;
-	//Set MVP(Total calculated, easier to multiply in the shader) for the shader.
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "MVP"), 1, GL_FALSE, &MVP[0][0]);
-	//Set individual components for shader calculations (Model, View, Projection).
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, &model[0][0]);
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, &view[0][0]);
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
-	//Update heights.
-	glUniform1f(glGetUniformLocation(shaderProgram, "max_height"), this->max_height);
-	glUniform1f(glGetUniformLocation(shaderProgram, "min_height"), this->min_height);
-	//Update viewPos.
-	glUniform3f(glGetUniformLocation(shaderProgram, "viewPos"), Window::camera_pos.x, Window::camera_pos.y, Window::camera_pos.z);
-	//Update toon_shade.
-	glUniform1i(glGetUniformLocation(shaderProgram, "toon_shade"), Window::toon_shading);
-	//Set draw_mode to view wireframe version or filled version.
-	if (draw_mode == DRAW_SHADED)
-	{
-		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-	}
-	else if (draw_mode == DRAW_WIREFRAME)
-	{
-		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	}
-	//Draw the terrain.
-	glBindVertexArray(VAO);//Bind the vertex.
-	
-	glActiveTexture(GL_TEXTURE0);//Enable the texture.
-	glBindTexture(GL_TEXTURE_2D, this->terrainTexture_0);
-	glUniform1i(glGetUniformLocation(shaderProgram, "TerrainTexture_0"), 0);
-
-	glActiveTexture(GL_TEXTURE1);//Enable the texture.
-	glBindTexture(GL_TEXTURE_2D, this->terrainTexture_1);
-	glUniform1i(glGetUniformLocation(shaderProgram, "TerrainTexture_1"), 1);
-
-	glActiveTexture(GL_TEXTURE2);//Enable the texture.
-	glBindTexture(GL_TEXTURE_2D, this->terrainTexture_2);
-	glUniform1i(glGetUniformLocation(shaderProgram, "TerrainTexture_2"), 2);
-
-	glActiveTexture(GL_TEXTURE3);//Enable the texture.
-	glBindTexture(GL_TEXTURE_2D, this->terrainTexture_3);
-	glUniform1i(glGetUniformLocation(shaderProgram, "TerrainTexture_3"), 3);
-
-	glActiveTexture(GL_TEXTURE4);//Enable the texture.
-	glBindTexture(GL_TEXTURE_2D, this->blendMap);
-	glUniform1i(glGetUniformLocation(shaderProgram, "blendMap"), 4);
-
-	glDrawElements(GL_TRIANGLES, (GLsizei)this->indices.size(), GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);//Unbind vertex.
-
-	//Set it back to fill.
-	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-	glEnable(GL_FOG);
-}
-
-/* Update the shader with new updated vertices. */
-void Terrain::update()
-{
-	glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, this->containers.size() * sizeof(Container), &this->containers[0]);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-}
-
-/* Stitches any attached terrains. */
-void Terrain::stitch_all()
-{
-	stitch_left();
-	stitch_right();
-	stitch_top();
-	stitch_bottom();
-	//Update normals
-	updateNormals();
-	update();
-}
-
-/* Stitches the terrain to the left of it. */
-void Terrain::stitch_left()
-{
-	//Base case to check if there's a defined left.
-	if (!terrain_left)
-		return;
-	//Perform stitching.
-	glm::vec3 cur_left = this->vertices[0];
-	glm::vec3 next_right = this->terrain_left->vertices[(VERTEX_COUNT - 1)];
-	float midpoint = next_right.y;
-
-	this->vertices[0].y = midpoint;
-	this->containers[0].vertex.y = midpoint;
-	this->update();
-
-	this->terrain_left->vertices[(VERTEX_COUNT - 1)].y = midpoint;
-	this->terrain_left->containers[(VERTEX_COUNT - 1)].vertex.y = midpoint;
-	this->terrain_left->update();
-
-	for (int i = 1; i < VERTEX_COUNT; i++)
-	{
-		glm::vec3 cur_left = this->vertices[(VERTEX_COUNT*i)];
-		glm::vec3 next_right = this->terrain_left->vertices[(VERTEX_COUNT *i) + (VERTEX_COUNT - 1)];
-		float midpoint = (cur_left.y + next_right.y) / 2.0f;
-
-		this->vertices[(VERTEX_COUNT*i)].y = midpoint;
-		this->containers[(VERTEX_COUNT*i)].vertex.y = midpoint;
-		this->update();
-
-		this->terrain_left->vertices[(VERTEX_COUNT *i) + (VERTEX_COUNT - 1)].y = midpoint;
-		this->terrain_left->containers[(VERTEX_COUNT *i) + (VERTEX_COUNT - 1)].vertex.y = midpoint;
-		this->terrain_left->update();
-	}
-}
-
-/* Stitches the terrain to the right of it. */
-void Terrain::stitch_right()
-{
-	//Base case to check if there's a defined right.
-	if (!terrain_right)
-		return;
-	//Perform stitching.
-	for (int i = 0; i < VERTEX_COUNT-1; i++)
-	{
-		glm::vec3 cur_right = this->vertices[(VERTEX_COUNT*i) + (VERTEX_COUNT - 1)];
-		glm::vec3 next_left = this->terrain_right->vertices[(VERTEX_COUNT*i)];
-		float midpoint = (cur_right.y + next_left.y) / 2.0f;
-
-		this->vertices[(VERTEX_COUNT*i) + (VERTEX_COUNT - 1)].y = midpoint;
-		this->containers[(VERTEX_COUNT*i) + (VERTEX_COUNT - 1)].vertex.y = midpoint;
-		this->update();
-
-		this->terrain_right->vertices[(VERTEX_COUNT*i)].y = midpoint;
-		this->terrain_right->containers[(VERTEX_COUNT*i)].vertex.y = midpoint;
-		this->terrain_right->update();
-	}
-
-	glm::vec3 cur_right = this->vertices[(VERTEX_COUNT*(VERTEX_COUNT-1)) + (VERTEX_COUNT - 1)];
-	glm::vec3 next_left = this->terrain_right->vertices[(VERTEX_COUNT*(VERTEX_COUNT - 1))];
-	float midpoint = next_left.y;
-
-	this->vertices[(VERTEX_COUNT*(VERTEX_COUNT - 1)) + (VERTEX_COUNT - 1)].y = midpoint;
-	this->containers[(VERTEX_COUNT*(VERTEX_COUNT - 1)) + (VERTEX_COUNT - 1)].vertex.y = midpoint;
-	this->update();
-
-	this->terrain_right->vertices[(VERTEX_COUNT*(VERTEX_COUNT - 1))].y = midpoint;
-	this->terrain_right->containers[(VERTEX_COUNT*(VERTEX_COUNT - 1))].vertex.y = midpoint;
-	this->terrain_right->update();
-
-}
-
-/* Stitches the terrain above it. AKA, negative z from this one. */
-void Terrain::stitch_top()
-{
-	//Base case to check if there's a defined top.
-	if (!terrain_top)
-		return;
-	//Perform stitching.
-	for (int i = 0; i < VERTEX_COUNT-1; i++)
-	{
-		glm::vec3 cur_top = this->vertices[i];
-		glm::vec3 next_bottom = this->terrain_top->vertices[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + i];
-		float midpoint = (cur_top.y + next_bottom.y) / 2.0f;
-
-		this->vertices[i].y = midpoint;
-		this->containers[i].vertex.y = midpoint;
-		this->update();
-
-		this->terrain_top->vertices[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + i].y = midpoint;
-		this->terrain_top->containers[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + i].vertex.y = midpoint;
-		this->terrain_top->update();
-	}
-
-	glm::vec3 cur_top = this->vertices[VERTEX_COUNT - 1];
-	glm::vec3 next_bottom = this->terrain_top->vertices[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + (VERTEX_COUNT - 1)];
-	float midpoint = next_bottom.y;
-
-	this->vertices[(VERTEX_COUNT - 1)].y = midpoint;
-	this->containers[(VERTEX_COUNT - 1)].vertex.y = midpoint;
-	this->update();
-
-	this->terrain_top->vertices[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + (VERTEX_COUNT - 1)].y = midpoint;
-	this->terrain_top->containers[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + (VERTEX_COUNT - 1)].vertex.y = midpoint;
-	this->terrain_top->update();
-}
-
-/* Stitches the terrain above it. AKA, positive z from this one. */
-void Terrain::stitch_bottom()
-{
-	//Base case to check if there's a defined bottom.
-	if (!terrain_bottom)
-		return;
-	//Perform stitching.
-	for (int i = 1; i < VERTEX_COUNT; i++)
-	{
-		glm::vec3 cur_bottom = this->vertices[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + i];
-		glm::vec3 next_top = this->terrain_bottom->vertices[i];
-		float midpoint = (cur_bottom.y + next_top.y) / 2.0f;
-
-		this->vertices[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + i].y = midpoint;
-		this->containers[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + i].vertex.y = midpoint;
-		this->update();
-
-		this->terrain_bottom->vertices[i].y = midpoint;
-		this->terrain_bottom->containers[i].vertex.y = midpoint;
-		this->terrain_bottom->update();
-	}
-}
-
-/* Returns the interpolated height for BaryCentric coordinates. */
-float Terrain::BaryCentric(glm::vec3 p1, glm::vec3 p2, glm::vec3 p3, glm::vec2 pos)
-{
-	float det = (p2.z - p3.z) * (p1.x - p3.x) + (p3.x - p2.x) * (p1.z - p3.z);
-
-	float l1 = ((p2.z - p3.z) * (pos.x - p3.x) + (p3.x - p2.x) * (pos.y - p3.z)) / det;
-	float l2 = ((p3.z - p1.z) * (pos.x - p3.x) + (p1.x - p3.x) * (pos.y - p3.z)) / det;
-	float l3 = 1.0f - l1 - l2;
-
-	return l1 * p1.y + l2 * p2.y + l3 * p3.y;
-}
-
-/* Gets the height of the terrain at a given position. */
-float Terrain::getHeight(glm::vec3 position)
-{
-	//Get the coordinates in terms of the terrain.
-	float terrain_x = position.x - this->x;
-	float terrain_z = position.z - this->z;
-	//Check for boundaries.
-	if (terrain_x > SIZE || terrain_z > SIZE) {
-		printf("Accessing a point out of bounds of this terrain. Please check to make sure we're accessing the proper terrain.\n");
-		return 0;
-	}
-	//Get grid coordinate to determine which vertices to interpolate.
-	float gridSize = (float)(SIZE) / (float)(VERTEX_COUNT-1);
-	float gridX = floor(terrain_x / gridSize);
-	float gridZ = floor(terrain_z / gridSize);
-	//Get xCoord and zCoord within the square.
-	float xCoord = fmod(terrain_x, gridSize) / gridSize;
-	float zCoord = fmod(terrain_z, gridSize) / gridSize;
-	//Compute the height between the triangles.
-	float answer;
-	if (xCoord <= (1 - zCoord))
-	{
-		answer = BaryCentric(glm::vec3(0.0f, this->vertices[gridZ*VERTEX_COUNT + gridX].y, 0.0f), glm::vec3(1.0f, this->vertices[gridZ*VERTEX_COUNT + gridX + 1].y, 0.0f), glm::vec3(0.0f, this->vertices[(gridZ + 1)*VERTEX_COUNT + gridX + 1].y, 1.0f), glm::vec2(xCoord, zCoord));
-	}
-	else
-	{
-		answer = BaryCentric(glm::vec3(1.0f, this->vertices[gridZ*VERTEX_COUNT + gridX + 1].y, 0.0f), glm::vec3(1.0f, this->vertices[(gridZ + 1)*VERTEX_COUNT + gridX + 1].y, 1.0f), glm::vec3(0.0f, this->vertices[(gridZ + 1)*VERTEX_COUNT + gridX].y, 1.0f), glm::vec2(xCoord, zCoord));
-	}
-	//Return the result.
-	return answer;
-}
+{
+	//Calculate combination of the model (toWorld), view (camera inverse), and perspective matrices. Send to shader.
+	glm::mat4 MVP = Window::P * Window::V * this->toWorld;
+	glm::mat4 model = this->toWorld;//We don't really need this, but we'll pass it through just in case.
+	glm::mat4 view = glm::mat4(glm::mat3(Window::V));//Remove translation from the view matrix.
+	glm::mat4 projection = Window::P;
+	//Set MVP(Total calculated, easier to multiply in the shader) for the shader.
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "MVP"), 1, GL_FALSE, &MVP[0][0]);
+	//Set individual components for shader calculations (Model, View, Projection).
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, &model[0][0]);
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, &view[0][0]);
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
+	//Grid size for working out xz and texCoords from the vertex ID.
+	glUniform1i(glGetUniformLocation(shaderProgram, "vertex_count"), VERTEX_COUNT);
+	glUniform1f(glGetUniformLocation(shaderProgram, "size"), (float)SIZE);
+	//Update heights.
+	glUniform1f(glGetUniformLocation(shaderProgram, "max_height"), this->max_height);
+	glUniform1f(glGetUniformLocation(shaderProgram, "min_height"), this->min_height);
+	//Update viewPos.
+	glUniform3f(glGetUniformLocation(shaderProgram, "viewPos"), Window::camera_pos.x, Window::camera_pos.y, Window::camera_pos.z);
+	//Update toon_shade.
+	glUniform1i(glGetUniformLocation(shaderProgram, "toon_shade"), Window::toon_shading);
+	//Set draw_mode to view wireframe version or filled version.
+	if (draw_mode == DRAW_SHADED)
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	}
+	else if (draw_mode == DRAW_WIREFRAME)
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	}
+	//Draw the terrain.
+	glBindVertexArray(VAO);//Bind the vertex.
+	
+	glActiveTexture(GL_TEXTURE0);//Enable the texture.
+	glBindTexture(GL_TEXTURE_2D, this->terrainTexture_0);
+	glUniform1i(glGetUniformLocation(shaderProgram, "TerrainTexture_0"), 0);
+
+	glActiveTexture(GL_TEXTURE1);//Enable the texture.
+	glBindTexture(GL_TEXTURE_2D, this->terrainTexture_1);
+	glUniform1i(glGetUniformLocation(shaderProgram, "TerrainTexture_1"), 1);
+
+	glActiveTexture(GL_TEXTURE2);//Enable the texture.
+	glBindTexture(GL_TEXTURE_2D, this->terrainTexture_2);
+	glUniform1i(glGetUniformLocation(shaderProgram, "TerrainTexture_2"), 2);
+
+	glActiveTexture(GL_TEXTURE3);//Enable the texture.
+	glBindTexture(GL_TEXTURE_2D, this->terrainTexture_3);
+	glUniform1i(glGetUniformLocation(shaderProgram, "TerrainTexture_3"), 3);
+
+	glActiveTexture(GL_TEXTURE4);//Enable the texture.
+	glBindTexture(GL_TEXTURE_2D, this->blendMap);
+	glUniform1i(glGetUniformLocation(shaderProgram, "blendMap"), 4);
+
+	//Draw each patch at its level of detail, snapping the sides that border a coarser patch.
+	for (int pz = 0; pz < grid->patch_count; pz++)
+	{
+		for (int px = 0; px < grid->patch_count; px++)
+		{
+			int lod = getPatchLOD(px, pz);
+			int mask = 0;
+			if (getNeighbourLOD(px - 1, pz) > lod)
+				mask |= TerrainGrid::COARSER_LEFT;
+			if (getNeighbourLOD(px + 1, pz) > lod)
+				mask |= TerrainGrid::COARSER_RIGHT;
+			if (getNeighbourLOD(px, pz - 1) > lod)
+				mask |= TerrainGrid::COARSER_TOP;
+			if (getNeighbourLOD(px, pz + 1) > lod)
+				mask |= TerrainGrid::COARSER_BOTTOM;
+			TerrainGrid::Range range = grid->getPatch(lod, mask);
+			GLint base = (pz * VERTEX_COUNT + px) * PATCH_SIZE;
+			glDrawElementsBaseVertex(GL_TRIANGLES, range.count, GL_UNSIGNED_INT, (GLvoid*)(range.offset * sizeof(GLuint)), base);
+		}
+	}
+	glBindVertexArray(0);//Unbind vertex.
+
+	//Set it back to fill.
+	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+	glEnable(GL_FOG);
+}
+
+/* Pick the level of detail of every patch from its distance to the camera. Every LOD_DISTANCE doubling drops one level, disabled draws everything at full detail. */
+void Terrain::selectLOD(glm::vec3 camera, bool enabled)
+{
+	if (grid == nullptr)
+		return;
+	float patch_world = (float)SIZE / (float)grid->patch_count;
+	for (int pz = 0; pz < grid->patch_count; pz++)
+	{
+		for (int px = 0; px < grid->patch_count; px++)
+		{
+			int lod = 0;
+			if (enabled)
+			{
+				//Distance from the camera to the closest point of the patch's bounds.
+				glm::vec3 lower = glm::vec3(this->x + px * patch_world, this->min_height, this->z + pz * patch_world);
+				glm::vec3 upper = glm::vec3(lower.x + patch_world, this->max_height, lower.z + patch_world);
+				float distance = glm::length(camera - glm::clamp(camera, lower, upper));
+				if (distance >= LOD_DISTANCE)
+				{
+					lod = (int)floor(log2(distance / LOD_DISTANCE)) + 1;
+				}
+				lod = glm::min(lod, grid->lod_count - 1);
+			}
+			patch_lods[pz * grid->patch_count + px] = lod;
+		}
+	}
+}
+
+/* Lower any patch that is more than one level coarser than a neighbour, including the edge patches of the linked terrains. Returns true if anything changed. */
+bool Terrain::limitLOD()
+{
+	if (grid == nullptr)
+		return false;
+	bool changed = false;
+	for (int pz = 0; pz < grid->patch_count; pz++)
+	{
+		for (int px = 0; px < grid->patch_count; px++)
+		{
+			int &lod = patch_lods[pz * grid->patch_count + px];
+			int neighbours[4] = { getNeighbourLOD(px - 1, pz), getNeighbourLOD(px + 1, pz), getNeighbourLOD(px, pz - 1), getNeighbourLOD(px, pz + 1) };
+			int limit = lod;
+			for (int n = 0; n < 4; n++)
+			{
+				if (neighbours[n] >= 0)
+					limit = glm::min(limit, neighbours[n] + 1);
+			}
+			if (limit < lod)
+			{
+				lod = limit;
+				changed = true;
+			}
+		}
+	}
+	return changed;
+}
+
+/* Return the level of detail of one of this terrain's patches. */
+int Terrain::getPatchLOD(int patch_x, int patch_z)
+{
+	if (patch_lods.empty())
+		return 0;
+	return patch_lods[patch_z * grid->patch_count + patch_x];
+}
+
+/* Return the level of detail of a patch, stepping into the linked terrain when it's past our edge. Missing neighbours never constrain us. */
+int Terrain::getNeighbourLOD(int patch_x, int patch_z)
+{
+	int count = grid->patch_count;
+	Terrain * terrain = this;
+	if (patch_x < 0)
+	{
+		terrain = terrain_left;
+		patch_x += count;
+	}
+	else if (patch_x >= count)
+	{
+		terrain = terrain_right;
+		patch_x -= count;
+	}
+	else if (patch_z < 0)
+	{
+		terrain = terrain_top;
+		patch_z += count;
+	}
+	else if (patch_z >= count)
+	{
+		terrain = terrain_bottom;
+		patch_z -= count;
+	}
+	if (terrain == nullptr || terrain->patch_lods.empty())
+		return -1;
+	return terrain->getPatchLOD(patch_x, patch_z);
+}
+
+/* Update the shader with new updated vertices. Re-uploads the whole terrain, use markDirtyRect and flush for partial changes. */
+void Terrain::update()
+{
+	markDirtyRect(0, 0, VERTEX_COUNT, VERTEX_COUNT);
+	flush();
+}
+
+/* Mark vertices [begin, end) as changed since the last upload. */
+void Terrain::markDirty(int begin, int end)
+{
+	dirty_spans.push_back(glm::ivec2(begin, end));
+}
+
+/* Upload only the changed vertices. Spans that are close together are merged so we don't issue a call per vertex. */
+void Terrain::flush()
+{
+	//Nothing to do, or setupTerrain hasn't created the buffer yet (it will mark everything).
+	if (dirty_spans.empty() || this->VBO == 0)
+		return;
+	//Sort the spans and merge any that overlap or are within DIRTY_MERGE_GAP of each other. A gap under a row is cheaper to upload again than to split, so any rectangle goes up as one span.
+	std::sort(dirty_spans.begin(), dirty_spans.end(), [](const glm::ivec2 &a, const glm::ivec2 &b) { return a.x < b.x; });
+	std::vector<glm::ivec2> merged;
+	merged.push_back(dirty_spans[0]);
+	for (int i = 1; i < (int)dirty_spans.size(); i++)
+	{
+		glm::ivec2 &last = merged.back();
+		if (dirty_spans[i].x <= last.y + DIRTY_MERGE_GAP)
+		{
+			last.y = glm::max(last.y, dirty_spans[i].y);
+		}
+		else
+		{
+			merged.push_back(dirty_spans[i]);
+		}
+	}
+	dirty_spans.clear();
+	//Pack and upload each span.
+	std::vector<TerrainVertex> terrainVertices;
+	glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+	for (glm::ivec2 span : merged)
+	{
+		terrainVertices.resize(span.y - span.x);
+		packVertices(span.x, span.y, &terrainVertices[0]);
+		glBufferSubData(GL_ARRAY_BUFFER, span.x * sizeof(TerrainVertex), terrainVertices.size() * sizeof(TerrainVertex), &terrainVertices[0]);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/* Stitches any attached terrains. Only marks the edges (and the normals next to them) dirty, call flush once every terrain is stitched. */
+void Terrain::stitch_all()
+{
+	stitch_left();
+	stitch_right();
+	stitch_top();
+	stitch_bottom();
+}
+
+/* Stitches the terrain to the left of it. */
+void Terrain::stitch_left()
+{
+	//Base case to check if there's a defined left.
+	if (!terrain_left)
+		return;
+	//Perform stitching. The edge meets in the middle of both terrains' own heights, the corners are shared with more terrains.
+	for (int i = 1; i < VERTEX_COUNT - 1; i++)
+	{
+		float midpoint = (this->getSourceHeight(0, i) + this->terrain_left->getSourceHeight(VERTEX_COUNT - 1, i)) / 2.0f;
+		this->heights[VERTEX_COUNT*i] = midpoint;
+		this->terrain_left->heights[(VERTEX_COUNT*i) + (VERTEX_COUNT - 1)] = midpoint;
+	}
+	this->markDirtyRect(0, 0, 1, VERTEX_COUNT);
+	this->terrain_left->markDirtyRect(VERTEX_COUNT - 1, 0, VERTEX_COUNT, VERTEX_COUNT);
+	this->stitch_corner(0, 0);
+	this->stitch_corner(0, VERTEX_COUNT - 1);
+}
+
+/* Stitches the terrain to the right of it. */
+void Terrain::stitch_right()
+{
+	//Base case to check if there's a defined right.
+	if (!terrain_right)
+		return;
+	//Perform stitching. The edge meets in the middle of both terrains' own heights, the corners are shared with more terrains.
+	for (int i = 1; i < VERTEX_COUNT - 1; i++)
+	{
+		float midpoint = (this->getSourceHeight(VERTEX_COUNT - 1, i) + this->terrain_right->getSourceHeight(0, i)) / 2.0f;
+		this->heights[(VERTEX_COUNT*i) + (VERTEX_COUNT - 1)] = midpoint;
+		this->terrain_right->heights[VERTEX_COUNT*i] = midpoint;
+	}
+	this->markDirtyRect(VERTEX_COUNT - 1, 0, VERTEX_COUNT, VERTEX_COUNT);
+	this->terrain_right->markDirtyRect(0, 0, 1, VERTEX_COUNT);
+	this->stitch_corner(VERTEX_COUNT - 1, 0);
+	this->stitch_corner(VERTEX_COUNT - 1, VERTEX_COUNT - 1);
+}
+
+/* Stitches the terrain above it. AKA, negative z from this one. */
+void Terrain::stitch_top()
+{
+	//Base case to check if there's a defined top.
+	if (!terrain_top)
+		return;
+	//Perform stitching. The edge meets in the middle of both terrains' own heights, the corners are shared with more terrains.
+	for (int i = 1; i < VERTEX_COUNT - 1; i++)
+	{
+		float midpoint = (this->getSourceHeight(i, 0) + this->terrain_top->getSourceHeight(i, VERTEX_COUNT - 1)) / 2.0f;
+		this->heights[i] = midpoint;
+		this->terrain_top->heights[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + i] = midpoint;
+	}
+	this->markDirtyRect(0, 0, VERTEX_COUNT, 1);
+	this->terrain_top->markDirtyRect(0, VERTEX_COUNT - 1, VERTEX_COUNT, VERTEX_COUNT);
+	this->stitch_corner(0, 0);
+	this->stitch_corner(VERTEX_COUNT - 1, 0);
+}
+
+/* Stitches the terrain above it. AKA, positive z from this one. */
+void Terrain::stitch_bottom()
+{
+	//Base case to check if there's a defined bottom.
+	if (!terrain_bottom)
+		return;
+	//Perform stitching. The edge meets in the middle of both terrains' own heights, the corners are shared with more terrains.
+	for (int i = 1; i < VERTEX_COUNT - 1; i++)
+	{
+		float midpoint = (this->getSourceHeight(i, VERTEX_COUNT - 1) + this->terrain_bottom->getSourceHeight(i, 0)) / 2.0f;
+		this->heights[(VERTEX_COUNT)*(VERTEX_COUNT - 1) + i] = midpoint;
+		this->terrain_bottom->heights[i] = midpoint;
+	}
+	this->markDirtyRect(0, VERTEX_COUNT - 1, VERTEX_COUNT, VERTEX_COUNT);
+	this->terrain_bottom->markDirtyRect(0, 0, VERTEX_COUNT, 1);
+	this->stitch_corner(0, VERTEX_COUNT - 1);
+	this->stitch_corner(VERTEX_COUNT - 1, VERTEX_COUNT - 1);
+}
+
+/* A corner is shared by up to four terrains: this one, the one beside it, the one above or below it and the one diagonally across, reached through either of the other two. Every one of them gets the average of their source heights at that point. */
+void Terrain::stitch_corner(int j, int i)
+{
+	Terrain * side = (j == 0) ? terrain_left : terrain_right;
+	Terrain * vertical = (i == 0) ? terrain_top : terrain_bottom;
+	Terrain * diagonal = nullptr;
+	if (side != nullptr)
+		diagonal = (i == 0) ? side->terrain_top : side->terrain_bottom;
+	if (diagonal == nullptr && vertical != nullptr)
+		diagonal = (j == 0) ? vertical->terrain_left : vertical->terrain_right;
+	//The same point in each terrain's own vertices.
+	Terrain * sharing[4] = { this, side, vertical, diagonal };
+	int corner_j[4] = { j, VERTEX_COUNT - 1 - j, j, VERTEX_COUNT - 1 - j };
+	int corner_i[4] = { i, i, VERTEX_COUNT - 1 - i, VERTEX_COUNT - 1 - i };
+	//Add them up in the same order (top left, top right, bottom left, bottom right of the corner) whichever terrain stitches, so the float sum comes out exactly the same.
+	float ordered[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	int count = 0;
+	for (int k = 0; k < 4; k++)
+	{
+		if (sharing[k] == nullptr)
+			continue;
+		int quadrant = (corner_j[k] == 0 ? 1 : 0) + (corner_i[k] == 0 ? 2 : 0);
+		ordered[quadrant] = sharing[k]->getSourceHeight(corner_j[k], corner_i[k]);
+		count++;
+	}
+	float sum = ((ordered[0] + ordered[1]) + ordered[2]) + ordered[3];
+	for (int k = 0; k < 4; k++)
+	{
+		if (sharing[k] == nullptr)
+			continue;
+		sharing[k]->heights[corner_i[k] * VERTEX_COUNT + corner_j[k]] = sum / count;
+		sharing[k]->markDirtyRect(corner_j[k], corner_i[k], corner_j[k] + 1, corner_i[k] + 1);
+	}
+}
+
+/* Return the world space box around the terrain, from its position and max/min height. */
+AABB Terrain::getBounds()
+{
+	AABB box;
+	box.lower = glm::vec3(this->x, this->min_height, this->z);
+	box.upper = glm::vec3(this->x + SIZE, this->max_height, this->z + SIZE);
+	return box;
+}
+
+/* Returns the interpolated height for BaryCentric coordinates. */
+float Terrain::BaryCentric(glm::vec3 p1, glm::vec3 p2, glm::vec3 p3, glm::vec2 pos)
+{
+	float det = (p2.z - p3.z) * (p1.x - p3.x) + (p3.x - p2.x) * (p1.z - p3.z);
+
+	float l1 = ((p2.z - p3.z) * (pos.x - p3.x) + (p3.x - p2.x) * (pos.y - p3.z)) / det;
+	float l2 = ((p3.z - p1.z) * (pos.x - p3.x) + (p1.x - p3.x) * (pos.y - p3.z)) / det;
+	float l3 = 1.0f - l1 - l2;
+
+	return l1 * p1.y + l2 * p2.y + l3 * p3.y;
+}
+
+/* Append the quadtree's 8x8 level for the horizon, finer nodes cost more than they hide. */
+void Terrain::getOccluders(std::vector<AABB> &boxes)
+{
+	quadtree.getBoxes(OCCLUDER_NODES, glm::vec3(this->x, 0.0f, this->z), boxes);
+}
+
+/* Cast a ray against the terrain. The quadtree works in the terrain's local space, so the origin is moved there and the hit distance comes back along direction. */
+bool Terrain::raycast(glm::vec3 origin, glm::vec3 direction, float max_distance, float &distance)
+{
+	if (heights.empty())
+		return false;
+	glm::vec3 local = origin - glm::vec3(this->x, 0.0f, this->z);
+	return quadtree.raycast(&heights[0], local, direction, max_distance, distance);
+}
+
+/* Gets the height of the terrain at a given position. */
+float Terrain::getHeight(glm::vec3 position)
+{
+	//Get the coordinates in terms of the terrain.
+	float terrain_x = position.x - this->x;
+	float terrain_z = position.z - this->z;
+	//Check for boundaries.
+	if (terrain_x > SIZE || terrain_z > SIZE) {
+		printf("Accessing a point out of bounds of this terrain. Please check to make sure we're accessing the proper terrain.\n");
+		return 0;
+	}
+	return getHeightAt(terrain_x, terrain_z);
+}
+
+/* Interpolate the height at (terrain_x, terrain_z) relative to the terrain, clamped onto it. Each grid square is split from top right to bottom left, the same as the indices. */
+float Terrain::getHeightAt(float terrain_x, float terrain_z)
+{
+	//Get grid coordinate to determine which vertices to interpolate. The far edge uses the last square.
+	float gridSize = (float)(SIZE) / (float)(VERTEX_COUNT-1);
+	float grid_x = glm::clamp(terrain_x / gridSize, 0.0f, (float)(VERTEX_COUNT - 1));
+	float grid_z = glm::clamp(terrain_z / gridSize, 0.0f, (float)(VERTEX_COUNT - 1));
+	int gridX = glm::min((int)grid_x, VERTEX_COUNT - 2);
+	int gridZ = glm::min((int)grid_z, VERTEX_COUNT - 2);
+	//Get xCoord and zCoord within the square.
+	float xCoord = grid_x - gridX;
+	float zCoord = grid_z - gridZ;
+	int index = gridZ*VERTEX_COUNT + gridX;
+	//Compute the height between the triangles.
+	float answer;
+	if (xCoord <= (1 - zCoord))
+	{
+		answer = BaryCentric(glm::vec3(0.0f, this->heights[index], 0.0f), glm::vec3(1.0f, this->heights[index + 1], 0.0f), glm::vec3(0.0f, this->heights[index + VERTEX_COUNT], 1.0f), glm::vec2(xCoord, zCoord));
+	}
+	else
+	{
+		answer = BaryCentric(glm::vec3(1.0f, this->heights[index + 1], 0.0f), glm::vec3(1.0f, this->heights[index + VERTEX_COUNT + 1], 1.0f), glm::vec3(0.0f, this->heights[index + VERTEX_COUNT], 1.0f), glm::vec2(xCoord, zCoord));
+	}
+	//Return the result.
+	return answer;
+}
+
+/* Gets the heights of many positions on this terrain at once: positions[order[n]] for n in [0, count), written to results[order[n]]. Positions are clamped onto the terrain and nothing is printed. Four positions at a time with SSE, the barycentric weights on a unit square reduce to two lerps per triangle. */
+void Terrain::getHeights(const glm::vec3 * positions, const int * order, int count, float * results)
+{
+	float gridSize = (float)(SIZE) / (float)(VERTEX_COUNT - 1);
+	const float * h = &this->heights[0];
+	int n = 0;
+#ifdef TERRAIN_SSE
+	__m128 origin_x = _mm_set1_ps(this->x);
+	__m128 origin_z = _mm_set1_ps(this->z);
+	__m128 scale = _mm_set1_ps(1.0f / gridSize);
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 last = _mm_set1_ps((float)(VERTEX_COUNT - 1));
+	__m128 last_square = _mm_set1_ps((float)(VERTEX_COUNT - 2));
+	for (; n + 4 <= count; n += 4)
+	{
+		const glm::vec3 &p0 = positions[order[n]];
+		const glm::vec3 &p1 = positions[order[n + 1]];
+		const glm::vec3 &p2 = positions[order[n + 2]];
+		const glm::vec3 &p3 = positions[order[n + 3]];
+		//Grid coordinates, clamped onto the terrain.
+		__m128 grid_x = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(p0.x, p1.x, p2.x, p3.x), origin_x), scale);
+		__m128 grid_z = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(p0.z, p1.z, p2.z, p3.z), origin_z), scale);
+		grid_x = _mm_min_ps(_mm_max_ps(grid_x, zero), last);
+		grid_z = _mm_min_ps(_mm_max_ps(grid_z, zero), last);
+		//Square and position within it, the far edge uses the last square.
+		__m128i square_x = _mm_cvttps_epi32(_mm_min_ps(grid_x, last_square));
+		__m128i square_z = _mm_cvttps_epi32(_mm_min_ps(grid_z, last_square));
+		__m128 x_coord = _mm_sub_ps(grid_x, _mm_cvtepi32_ps(square_x));
+		__m128 z_coord = _mm_sub_ps(grid_z, _mm_cvtepi32_ps(square_z));
+		//Gather the 4 corners of each square.
+		int column[4], row[4], index[4];
+		_mm_storeu_si128((__m128i *)column, square_x);
+		_mm_storeu_si128((__m128i *)row, square_z);
+		for (int k = 0; k < 4; k++)
+		{
+			index[k] = row[k] * VERTEX_COUNT + column[k];
+		}
+		__m128 height_00 = _mm_setr_ps(h[index[0]], h[index[1]], h[index[2]], h[index[3]]);
+		__m128 height_10 = _mm_setr_ps(h[index[0] + 1], h[index[1] + 1], h[index[2] + 1], h[index[3] + 1]);
+		__m128 height_01 = _mm_setr_ps(h[index[0] + VERTEX_COUNT], h[index[1] + VERTEX_COUNT], h[index[2] + VERTEX_COUNT], h[index[3] + VERTEX_COUNT]);
+		__m128 height_11 = _mm_setr_ps(h[index[0] + VERTEX_COUNT + 1], h[index[1] + VERTEX_COUNT + 1], h[index[2] + VERTEX_COUNT + 1], h[index[3] + VERTEX_COUNT + 1]);
+		//Top left triangle: h00 + (h10 - h00) * x + (h01 - h00) * z.
+		__m128 top = _mm_add_ps(height_00, _mm_add_ps(_mm_mul_ps(_mm_sub_ps(height_10, height_00), x_coord), _mm_mul_ps(_mm_sub_ps(height_01, height_00), z_coord)));
+		//Bottom right triangle: h11 + (h01 - h11) * (1 - x) + (h10 - h11) * (1 - z).
+		__m128 bottom = _mm_add_ps(height_11, _mm_add_ps(_mm_mul_ps(_mm_sub_ps(height_01, height_11), _mm_sub_ps(one, x_coord)), _mm_mul_ps(_mm_sub_ps(height_10, height_11), _mm_sub_ps(one, z_coord))));
+		//Pick the triangle each position is in.
+		__m128 in_top = _mm_cmple_ps(_mm_add_ps(x_coord, z_coord), one);
+		float answer[4];
+		_mm_storeu_ps(answer, _mm_or_ps(_mm_and_ps(in_top, top), _mm_andnot_ps(in_top, bottom)));
+		for (int k = 0; k < 4; k++)
+		{
+			results[order[n + k]] = answer[k];
+		}
+	}
+#endif
+	//Whatever is left over.
+	for (; n < count; n++)
+	{
+		const glm::vec3 &position = positions[order[n]];
+		results[order[n]] = getHeightAt(position.x - this->x, position.z - this->z);
+	}
+}
@@ -1,70 +1,126 @@
-#pragma once
-#ifndef TERRAIN_H
-#define TERRAIN_H
-
-#include "Window.h"
-#include "Definitions.h"
-
-class Terrain
-{
-private:
-	//Determine the textures mapped to the terrain, using a blend map.
-	GLuint terrainTexture_0;
-	GLuint terrainTexture_1;
-	GLuint terrainTexture_2;
-	GLuint terrainTexture_3;
-	GLuint blendMap;
-	//Variables to keep track of information.
-	std::vector<Container> containers;//[v, vn, (s,t)]
-	std::vector<glm::vec3> vertices;//v
-	std::vector<glm::vec3> normals;//vn
-	std::vector<glm::vec2> texCoords;//(s,t)
-	std::vector<unsigned int> indices;//indices.
-	//Keep track of the max and min height if height map is loaded.
-	float max_height;
-	float min_height;
-	GLuint VAO, VBO, EBO;
-	//Flat terrain map.
-	void setupHeightMap();
-	//Functions for procedural terrain modeling.
-	void setupHeightMap(const char* filename, float n_smooth, float n_range);
-	float getHeightFromMap(int x, int y, unsigned char * image, int width, int height);
-	float getHeightFromVertex(int x, int y);
-	void diamond_square(int x1, int x2, int y1, int y2, int level, float range);
-	void updateNormals();
-	void updateMaxMinHeight();
-	//Load and setup the textures and heightmaps.
-	unsigned char * loadPPM(const char* filename, int& width, int& height);
-	GLuint loadTerrain(const char* filename, int index);
-	void setupTerrain(const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map);
-	//Misc.
-	float BaryCentric(glm::vec3 p1, glm::vec3 p2, glm::vec3 p3, glm::vec2 pos);
-	int draw_mode;
-
-public:
-	//Constructor methods.
-	Terrain(int x_d, int z_d, const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map);
-	Terrain(int x_d, int z_d, const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map, const char* height_map);
-	~Terrain();
-	//Determine the terrain's position in the world.
-	float x, z;
-	glm::mat4 toWorld;
-	//Draw and update methods.
-	void toggleDrawMode();
-	void draw(GLuint shaderProgram);
-	void update();
-	//Keep track of surrounding terrains to stitch them together.
-	Terrain * terrain_top;
-	Terrain * terrain_bottom;
-	Terrain * terrain_left;
-	Terrain * terrain_right;
-	//Functions to stitch the edges.
-	void stitch_all();
-	void stitch_left();
-	void stitch_right(); 
-	void stitch_top();
-	void stitch_bottom();
-	//Functions to get the height of the terrain.
-	float getHeight(glm::vec3 position);
-};
+#pragma once
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include "Window.h"
+#include "Definitions.h"
+#include "TerrainGrid.h"
+#include "TerrainCache.h"
+#include "TerrainQuadtree.h"
+
+class Terrain
+{
+private:
+	//Determine the textures mapped to the terrain, using a blend map.
+	GLuint terrainTexture_0;
+	GLuint terrainTexture_1;
+	GLuint terrainTexture_2;
+	GLuint terrainTexture_3;
+	GLuint blendMap;
+	//Variables to keep track of information. Only y is kept per terrain: (x, z) and (s, t) come from the vertex ID, vn is worked out from the heights when packing and the grid holds the indices.
+	std::vector<float> heights;//y
+	//Min/max heights over the cells for ray casts, refit whenever heights change.
+	TerrainQuadtree quadtree;
+	TerrainGrid * grid;
+	//Cooked tile to upload from instead of packing the heights and normals, released once uploaded.
+	TerrainCache * cooked;
+	//Vertex ranges [begin, end) changed since the last upload.
+	std::vector<glm::ivec2> dirty_spans;
+	//Level of detail of every patch, row by row. Chosen by selectLOD every frame.
+	std::vector<int> patch_lods;
+	int getNeighbourLOD(int patch_x, int patch_z);
+	//Heights worked out by sculpt for the vertices [x0, x1) x [z0, z1) in sculpt_rect, written by applySculpt.
+	std::vector<float> sculpt_heights;
+	glm::ivec4 sculpt_rect;
+	float getSharedHeight(int j, int i);
+	//Each edge as it was before stitching, or as last sculpted: the left and right columns, then the top and bottom rows. Stitching only ever averages these, so a shared edge depends on the two terrains' own heights and not on what it was stitched to before.
+	std::vector<float> source_edges;
+	void saveSourceEdges(int x0, int z0, int x1, int z1);
+	float getSourceHeight(int j, int i);
+	//Set the corner (j, i) on this terrain and every linked terrain sharing it to the average of their source heights there.
+	void stitch_corner(int j, int i);
+	//Put the edge on side back to this terrain's own heights, once the neighbour there is gone.
+	void restoreEdge(int side);
+	//Keep track of the max and min height if height map is loaded.
+	float max_height;
+	float min_height;
+	GLuint VAO, VBO;
+	//Flat terrain map.
+	void setupHeightMap();
+	//Functions for procedural terrain modeling.
+	void setupHeightMap(const char* filename, float n_smooth, float n_range);
+	float getHeightFromMap(int x, int y, unsigned char * image, int width, int height);
+	float getHeightFromVertex(int x, int y);
+	glm::vec3 getNormal(int j, int i);
+	static GLuint packNormal(glm::vec3 normal);
+	void packVertices(int begin, int end, TerrainVertex * out);
+	void diamond_square(int x1, int x2, int y1, int y2, int level, float range);
+	unsigned int seed;
+	void updateMaxMinHeight();
+	//Load and setup the textures and heightmaps.
+	unsigned char * loadPPM(const char* filename, int& width, int& height);
+	//Misc.
+	float BaryCentric(glm::vec3 p1, glm::vec3 p2, glm::vec3 p3, glm::vec2 pos);
+	float getHeightAt(float terrain_x, float terrain_z);
+	int draw_mode;
+
+public:
+	//Constructor methods.
+	Terrain(int x_d, int z_d, const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map);
+	Terrain(int x_d, int z_d, const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map, const char* height_map);
+	//CPU only constructor, safe to run on a worker thread. Call setupTerrain on the GL thread before drawing.
+	Terrain(int x_d, int z_d, const char* height_map);
+	//CPU only constructor from a cooked tile, nothing is parsed or generated. Takes ownership of the cache.
+	Terrain(int x_d, int z_d, TerrainCache * cooked);
+	~Terrain();
+	//Load the textures and upload the VAO, VBO for the terrain. Must run on the GL thread.
+	void setupTerrain(const char* terrain_0, const char* terrain_1, const char* terrain_2, const char* terrain_3, const char* blend_map);
+	//Cooking: the key covers the generation parameters, the tile position and the source height map's hash.
+	static unsigned long long getCookKey(int x_d, int z_d, unsigned long long source);
+	static TerrainCache * openCooked(const std::string &filename, unsigned long long key);
+	bool cook(const std::string &filename, unsigned long long key);
+	//Determine the terrain's position in the world.
+	float x, z;
+	glm::mat4 toWorld;
+	//Draw and update methods.
+	void toggleDrawMode();
+	void draw(GLuint shaderProgram);
+	void update();
+	//Track changed vertices and upload only those, once, in flush.
+	void markDirty(int begin, int end);
+	//Mark a rectangle of changed heights [x0, x1) x [z0, z1) in vertices, with the normals around it here and in the neighbours.
+	void markDirtyRect(int x0, int z0, int x1, int z1);
+	void flush();
+	//Recompute every normal on the next flush, stitching and edits only need markDirtyRect.
+	void updateNormals();
+	//Sculpting in two passes, so terrains sharing an edge both read the heights from before the stroke: sculpt works out the new heights under the brush, applySculpt writes them and marks the rectangle.
+	void sculpt(const Brush &brush);
+	void applySculpt();
+	//Detach from the linked terrains and mark their edges, before this one is deleted.
+	void unlink();
+	//Level of detail: pick each patch's level from the camera distance, then limitLOD until no neighbours (here or in the linked terrains) differ by more than one level.
+	void selectLOD(glm::vec3 camera, bool enabled);
+	bool limitLOD();
+	int getPatchLOD(int patch_x, int patch_z);
+	//Keep track of surrounding terrains to stitch them together.
+	Terrain * terrain_top;
+	Terrain * terrain_bottom;
+	Terrain * terrain_left;
+	Terrain * terrain_right;
+	//Functions to stitch the edges. Stitching again gives the same result, whatever was stitched or unlinked before.
+	void stitch_all();
+	void stitch_left();
+	void stitch_right(); 
+	void stitch_top();
+	void stitch_bottom();
+	//Functions to get the height of the terrain.
+	float getHeight(glm::vec3 position);
+	//Nearest point within max_distance where the ray hits this terrain, in world space.
+	bool raycast(glm::vec3 origin, glm::vec3 direction, float max_distance, float &distance);
+	void getHeights(const glm::vec3 * positions, const int * order, int count, float * results);
+	//World space box around the terrain, for culling.
+	AABB getBounds();
+	//Quadtree node boxes for horizon culling, the ground inside each never drops below its lower y.
+	void getOccluders(std::vector<AABB> &boxes);
+};
 #endif
\ No newline at end of file
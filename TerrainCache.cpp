@@ -0,0 +1,166 @@
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "TerrainCache.h"
+#include <cstring>
+
+#define COOK_VERSION 3
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+#define HASH_BUFFER_SIZE 65536
+
+/* Empty cache, open fills it in. */
+TerrainCache::TerrainCache()
+{
+	this->data = nullptr;
+	this->size = 0;
+#ifdef _WIN32
+	this->file = INVALID_HANDLE_VALUE;
+	this->mapping = nullptr;
+#endif
+	this->vertices = nullptr;
+	this->vertex_count = 0;
+	this->min_height = 0;
+	this->max_height = 0;
+}
+
+/* Deconstructor unmaps the file. */
+TerrainCache::~TerrainCache()
+{
+#ifdef _WIN32
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+#else
+	if (data != nullptr)
+		munmap(data, size);
+#endif
+}
+
+/* Map the cooked file and check it was cooked for this key. */
+TerrainCache * TerrainCache::open(const std::string &filename, unsigned long long key, int vertex_count)
+{
+	TerrainCache * cache = new TerrainCache();
+	//Map the whole file read only.
+#ifdef _WIN32
+	cache->file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER file_size;
+	if (cache->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(cache->file, &file_size) || file_size.QuadPart == 0)
+	{
+		delete(cache);
+		return nullptr;
+	}
+	cache->size = (size_t)file_size.QuadPart;
+	cache->mapping = CreateFileMappingA(cache->file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (cache->mapping != nullptr)
+	{
+		cache->data = MapViewOfFile(cache->mapping, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (cache->data == nullptr)
+	{
+		delete(cache);
+		return nullptr;
+	}
+#else
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	struct stat file_stat;
+	if (fd < 0 || fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+	{
+		if (fd >= 0)
+			close(fd);
+		delete(cache);
+		return nullptr;
+	}
+	cache->size = (size_t)file_stat.st_size;
+	void * data = mmap(NULL, cache->size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		delete(cache);
+		return nullptr;
+	}
+	cache->data = data;
+#endif
+	//Check the header and that the tile is all there.
+	const Header * header = (const Header *)cache->data;
+	size_t expected = sizeof(Header) + (size_t)vertex_count * vertex_count * sizeof(TerrainVertex);
+	if (cache->size != expected || memcmp(header->magic, "TRNC", 4) != 0 || header->version != COOK_VERSION || header->key != key || header->vertex_count != vertex_count)
+	{
+		delete(cache);
+		return nullptr;
+	}
+	cache->vertices = (const TerrainVertex *)((const char *)cache->data + sizeof(Header));
+	cache->vertex_count = header->vertex_count;
+	cache->min_height = header->min_height;
+	cache->max_height = header->max_height;
+	return cache;
+}
+
+/* Write the header and the tile in upload layout. */
+bool TerrainCache::write(const std::string &filename, unsigned long long key, const std::vector<TerrainVertex> &vertices, float min_height, float max_height)
+{
+	FILE* fp;
+	if ((fp = fopen(filename.c_str(), "wb")) == NULL)
+	{
+		std::cerr << "error writing cooked terrain, could not open " << filename << std::endl;
+		return false;
+	}
+	Header header;
+	memcpy(header.magic, "TRNC", 4);
+	header.version = COOK_VERSION;
+	header.key = key;
+	header.vertex_count = (int)sqrt((double)vertices.size());
+	header.min_height = min_height;
+	header.max_height = max_height;
+	bool written = fwrite(&header, sizeof(Header), 1, fp) == 1;
+	written = written && fwrite(&vertices[0], sizeof(TerrainVertex), vertices.size(), fp) == vertices.size();
+	fclose(fp);
+	if (!written)
+	{
+		std::cerr << "error writing cooked terrain, incomplete data in " << filename << std::endl;
+		remove(filename.c_str());
+	}
+	return written;
+}
+
+/* Fold bytes into the hash. Start with a seed of 0 for a fresh hash. */
+unsigned long long TerrainCache::hash(unsigned long long seed, const void * bytes, size_t count)
+{
+	unsigned long long h = (seed == 0) ? FNV_OFFSET : seed;
+	const unsigned char * data = (const unsigned char *)bytes;
+	for (size_t i = 0; i < count; i++)
+	{
+		h ^= data[i];
+		h *= FNV_PRIME;
+	}
+	return h;
+}
+
+/* Hash the contents of a file, 0 if it can't be read. */
+unsigned long long TerrainCache::hashFile(const char* filename)
+{
+	FILE* fp;
+	if ((fp = fopen(filename, "rb")) == NULL)
+	{
+		return 0;
+	}
+	std::vector<unsigned char> buffer(HASH_BUFFER_SIZE);
+	unsigned long long h = 0;
+	size_t read;
+	while ((read = fread(&buffer[0], 1, buffer.size(), fp)) > 0)
+	{
+		h = hash(h, &buffer[0], read);
+	}
+	fclose(fp);
+	return h;
+}
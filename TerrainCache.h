@@ -0,0 +1,46 @@
+#pragma once
+#ifndef TERRAINCACHE_H
+#define TERRAINCACHE_H
+
+#include "Window.h"
+#include "Definitions.h"
+#include <string>
+
+/* A cooked terrain tile: the final heights, normals and max/min height in the same layout the terrain uploads, memory mapped straight from disk. Files are versioned and tagged with the key they were cooked from, a mismatch just means the tile needs cooking again. */
+class TerrainCache
+{
+private:
+	//The file's header, followed by vertex_count * vertex_count TerrainVertex.
+	struct Header {
+		char magic[4];
+		unsigned int version;
+		unsigned long long key;
+		int vertex_count;
+		float min_height;
+		float max_height;
+	};
+	//The mapping, kept until the cache is deleted.
+	void * data;
+	size_t size;
+#ifdef _WIN32
+	void * file;
+	void * mapping;
+#endif
+	TerrainCache();
+
+public:
+	~TerrainCache();
+	//Map a cooked tile, returns nullptr if it's missing, from another version or cooked with a different key.
+	static TerrainCache * open(const std::string &filename, unsigned long long key, int vertex_count);
+	//Cook a tile to disk. Returns false if the file couldn't be written.
+	static bool write(const std::string &filename, unsigned long long key, const std::vector<TerrainVertex> &vertices, float min_height, float max_height);
+	//FNV-1a hashing, for keys built from file contents and generation parameters.
+	static unsigned long long hash(unsigned long long seed, const void * bytes, size_t count);
+	static unsigned long long hashFile(const char* filename);
+	//Contents of the mapped tile.
+	const TerrainVertex * vertices;
+	int vertex_count;
+	float min_height;
+	float max_height;
+};
+#endif
@@ -0,0 +1,128 @@
+#include "TerrainGrid.h"
+#include <algorithm>
+
+TerrainGrid * TerrainGrid::shared = nullptr;
+int TerrainGrid::references = 0;
+
+/* Build the indices for every level of detail once and upload them. */
+TerrainGrid::TerrainGrid(int vertex_count, int patch_size)
+{
+	this->vertex_count = vertex_count;
+	this->patch_size = patch_size;
+	this->patch_count = (vertex_count - 1) / patch_size;
+	this->lod_count = 1;
+	while ((1 << (this->lod_count - 1)) < patch_size)
+	{
+		this->lod_count++;
+	}
+	//Setup the indices of one patch for every level of detail and every combination of coarser neighbours.
+	std::vector<unsigned int> indices;
+	for (int lod = 0; lod < this->lod_count; lod++)
+	{
+		for (int mask = 0; mask < MASKS; mask++)
+		{
+			Range range;
+			range.offset = (GLsizei)indices.size();
+			buildPatch(lod, mask, indices);
+			range.count = (GLsizei)indices.size() - range.offset;
+			this->patches.push_back(range);
+		}
+	}
+	//Upload, every terrain VAO binds these. The EBO goes through GL_ARRAY_BUFFER since no VAO is bound here.
+	glGenBuffers(1, &this->EBO);
+	glBindBuffer(GL_ARRAY_BUFFER, this->EBO);
+	glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/* Append the triangles of a patch at the given level of detail. Vertices on a side in mask are snapped down to the coarser lattice, which collapses every other triangle on that edge so it matches the coarser neighbour. */
+void TerrainGrid::buildPatch(int lod, int mask, std::vector<unsigned int> &indices)
+{
+	int step = 1 << lod;
+	int coarse = step * 2;
+	//The coarsest level has no coarser neighbour.
+	if (coarse > patch_size)
+	{
+		mask = 0;
+	}
+	for (int gz = 0; gz < patch_size; gz += step)
+	{
+		for (int gx = 0; gx < patch_size; gx += step)
+		{
+			//Corners of the cell as (x, z), top left first.
+			int corner_x[4] = { gx, gx + step, gx, gx + step };
+			int corner_z[4] = { gz, gz, gz + step, gz + step };
+			unsigned int corner[4];
+			for (int c = 0; c < 4; c++)
+			{
+				int vx = corner_x[c];
+				int vz = corner_z[c];
+				if (((mask & COARSER_LEFT) && vx == 0) || ((mask & COARSER_RIGHT) && vx == patch_size))
+				{
+					vz = (vz / coarse) * coarse;
+				}
+				if (((mask & COARSER_TOP) && vz == 0) || ((mask & COARSER_BOTTOM) && vz == patch_size))
+				{
+					vx = (vx / coarse) * coarse;
+				}
+				corner[c] = vz * vertex_count + vx;
+			}
+			unsigned int topLeft = corner[0];
+			unsigned int topRight = corner[1];
+			unsigned int bottomLeft = corner[2];
+			unsigned int bottomRight = corner[3];
+			//Cells are split from top right to bottom left, the same diagonal the height queries and ray casts use. Only the bottom right cell with both its right and bottom sides snapped takes the other one, since snapping both folds it over.
+			unsigned int triangles[6] = { topLeft, bottomLeft, topRight, topRight, bottomLeft, bottomRight };
+			if (gx == patch_size - step && gz == patch_size - step && (mask & COARSER_RIGHT) && (mask & COARSER_BOTTOM))
+			{
+				unsigned int flipped[6] = { topLeft, bottomLeft, bottomRight, topLeft, bottomRight, topRight };
+				std::copy(flipped, flipped + 6, triangles);
+			}
+			//Push back to indices, skipping the triangles that snapping collapsed.
+			for (int t = 0; t < 6; t += 3)
+			{
+				unsigned int a = triangles[t], b = triangles[t + 1], c = triangles[t + 2];
+				if (a != b && b != c && a != c)
+				{
+					indices.push_back(a);
+					indices.push_back(b);
+					indices.push_back(c);
+				}
+			}
+		}
+	}
+}
+
+/* Return the index range for a patch at lod with the given coarser sides. */
+TerrainGrid::Range TerrainGrid::getPatch(int lod, int mask)
+{
+	return patches[lod * MASKS + mask];
+}
+
+/* Deconstructor to safely delete when finished. */
+TerrainGrid::~TerrainGrid()
+{
+	glDeleteBuffers(1, &EBO);
+}
+
+/* Return the shared grid and add a reference to it. */
+TerrainGrid * TerrainGrid::acquire(int vertex_count, int patch_size)
+{
+	if (shared == nullptr)
+	{
+		shared = new TerrainGrid(vertex_count, patch_size);
+	}
+	references++;
+	return shared;
+}
+
+/* Drop a reference, the grid is deleted with the last one. */
+void TerrainGrid::release()
+{
+	references--;
+	if (references == 0)
+	{
+		delete(shared);
+		shared = nullptr;
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef TERRAINGRID_H
+#define TERRAINGRID_H
+
+#include "Window.h"
+
+/* The grid every terrain tile is drawn on. Only the heights and normals differ between tiles and the xz positions and texCoords come from the vertex ID, so the indices are uploaded once and shared. */
+class TerrainGrid
+{
+private:
+	//One shared instance, deleted when the last terrain releases it.
+	static TerrainGrid * shared;
+	static int references;
+	TerrainGrid(int vertex_count, int patch_size);
+	~TerrainGrid();
+	//Index a patch at one level of detail, snapping the edges in mask to the next coarser level.
+	void buildPatch(int lod, int mask, std::vector<unsigned int> &indices);
+
+public:
+	//Sides of a patch whose neighbour is one level coarser. The edge vertices on that side are snapped so there are no cracks.
+	enum { COARSER_LEFT = 1, COARSER_RIGHT = 2, COARSER_TOP = 4, COARSER_BOTTOM = 8, MASKS = 16 };
+	//Where one patch's indices live in the EBO.
+	struct Range {
+		GLsizei offset;
+		GLsizei count;
+	};
+	//Get the shared grid, creating it on first use. Must run on the GL thread.
+	static TerrainGrid * acquire(int vertex_count, int patch_size);
+	static void release();
+	//The indices for a patch at lod with the given coarser sides, relative to the patch's top left vertex.
+	Range getPatch(int lod, int mask);
+	//The triangle indices of every (lod, mask).
+	GLuint EBO;
+	std::vector<Range> patches;
+	int vertex_count;
+	//Cells per patch side, patches per tile side and number of levels (the last one is a single cell).
+	int patch_size;
+	int patch_count;
+	int lod_count;
+};
+#endif
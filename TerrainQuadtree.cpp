@@ -0,0 +1,248 @@
+#include "TerrainQuadtree.h"
+
+#define RAY_EPSILON 1e-7f
+#define MAX_DEPTH 32
+
+TerrainQuadtree::TerrainQuadtree()
+{
+	this->cells = 0;
+	this->vertex_count = 0;
+	this->cell_size = 1.0f;
+}
+
+/* Build every level of the tree from the heights. */
+void TerrainQuadtree::build(const float * heights, int vertex_count, float cell_size)
+{
+	this->vertex_count = vertex_count;
+	this->cells = vertex_count - 1;
+	this->cell_size = cell_size;
+	//Halve the cells per side until one node covers the tile, rounding up for odd sizes.
+	levels.clear();
+	sides.clear();
+	int side = cells;
+	while (true)
+	{
+		levels.push_back(std::vector<glm::vec2>(side * side));
+		sides.push_back(side);
+		if (side == 1)
+			break;
+		side = (side + 1) / 2;
+	}
+	refit(heights, 0, 0, cells, cells);
+}
+
+/* Refit the nodes over vertices [x0, x1) x [z0, z1). A vertex is a corner of up to four cells, so the cells before the rectangle are refit too. */
+void TerrainQuadtree::update(const float * heights, int x0, int z0, int x1, int z1)
+{
+	if (levels.empty())
+		return;
+	refit(heights, glm::max(x0 - 1, 0), glm::max(z0 - 1, 0), glm::min(x1, cells), glm::min(z1, cells));
+}
+
+/* Refit the cells from their corner heights, then every parent above them. */
+void TerrainQuadtree::refit(const float * heights, int cx0, int cz0, int cx1, int cz1)
+{
+	std::vector<glm::vec2> &leaves = levels[0];
+	for (int cz = cz0; cz < cz1; cz++)
+	{
+		const float * row = heights + cz * vertex_count;
+		const float * next = row + vertex_count;
+		for (int cx = cx0; cx < cx1; cx++)
+		{
+			float a = row[cx], b = row[cx + 1], c = next[cx], d = next[cx + 1];
+			leaves[cz * cells + cx] = glm::vec2(glm::min(glm::min(a, b), glm::min(c, d)), glm::max(glm::max(a, b), glm::max(c, d)));
+		}
+	}
+	//Each parent covers up to 2x2 children.
+	for (int level = 1; level < (int)levels.size(); level++)
+	{
+		int side = sides[level - 1];
+		int parent_side = sides[level];
+		cx0 /= 2;
+		cz0 /= 2;
+		cx1 = (cx1 + 1) / 2;
+		cz1 = (cz1 + 1) / 2;
+		std::vector<glm::vec2> &children = levels[level - 1];
+		std::vector<glm::vec2> &parents = levels[level];
+		for (int pz = cz0; pz < cz1; pz++)
+		{
+			for (int px = cx0; px < cx1; px++)
+			{
+				glm::vec2 range(INFINITY, -INFINITY);
+				for (int k = 0; k < 4; k++)
+				{
+					int x = px * 2 + (k & 1);
+					int z = pz * 2 + (k >> 1);
+					if (x < side && z < side)
+					{
+						range.x = glm::min(range.x, children[z * side + x].x);
+						range.y = glm::max(range.y, children[z * side + x].y);
+					}
+				}
+				parents[pz * parent_side + px] = range;
+			}
+		}
+	}
+}
+
+/* Return the min and max height of the tile. */
+glm::vec2 TerrainQuadtree::getRange()
+{
+	if (levels.empty())
+		return glm::vec2(0.0f);
+	return levels.back()[0];
+}
+
+/* Append the boxes of every node on the first level coarse enough, for occlusion. */
+void TerrainQuadtree::getBoxes(int max_side, glm::vec3 offset, std::vector<AABB> &boxes)
+{
+	int level = 0;
+	while (level < (int)levels.size() - 1 && sides[level] > max_side)
+	{
+		level++;
+	}
+	if (levels.empty())
+		return;
+	int side = sides[level];
+	int span = 1 << level;
+	for (int z = 0; z < side; z++)
+	{
+		for (int x = 0; x < side; x++)
+		{
+			glm::vec2 range = levels[level][z * side + x];
+			AABB box;
+			box.lower = offset + glm::vec3(x * span * cell_size, range.x, z * span * cell_size);
+			box.upper = offset + glm::vec3(glm::min((x + 1) * span, cells) * cell_size, range.y, glm::min((z + 1) * span, cells) * cell_size);
+			boxes.push_back(box);
+		}
+	}
+}
+
+/* Moller-Trumbore, both sides count as a hit. */
+bool TerrainQuadtree::hitTriangle(glm::vec3 a, glm::vec3 b, glm::vec3 c, glm::vec3 origin, glm::vec3 direction, float &t)
+{
+	glm::vec3 edge_1 = b - a;
+	glm::vec3 edge_2 = c - a;
+	glm::vec3 p = glm::cross(direction, edge_2);
+	float determinant = glm::dot(edge_1, p);
+	if (fabs(determinant) < RAY_EPSILON)
+		return false;
+	float inverse = 1.0f / determinant;
+	glm::vec3 offset = origin - a;
+	float u = glm::dot(offset, p) * inverse;
+	if (u < 0.0f || u > 1.0f)
+		return false;
+	glm::vec3 q = glm::cross(offset, edge_1);
+	float v = glm::dot(direction, q) * inverse;
+	if (v < 0.0f || u + v > 1.0f)
+		return false;
+	t = glm::dot(edge_2, q) * inverse;
+	return t >= 0.0f;
+}
+
+/* Test both triangles of the cell and keep the nearest hit. */
+bool TerrainQuadtree::hitCell(const float * heights, int cx, int cz, glm::vec3 origin, glm::vec3 direction, float &t)
+{
+	int index = cz * vertex_count + cx;
+	float x0 = cx * cell_size, x1 = (cx + 1) * cell_size;
+	float z0 = cz * cell_size, z1 = (cz + 1) * cell_size;
+	glm::vec3 top_left(x0, heights[index], z0);
+	glm::vec3 top_right(x1, heights[index + 1], z0);
+	glm::vec3 bottom_left(x0, heights[index + vertex_count], z1);
+	glm::vec3 bottom_right(x1, heights[index + vertex_count + 1], z1);
+	bool hit = false;
+	float hit_t;
+	if (hitTriangle(top_left, top_right, bottom_left, origin, direction, hit_t))
+	{
+		t = hit_t;
+		hit = true;
+	}
+	if (hitTriangle(top_right, bottom_right, bottom_left, origin, direction, hit_t) && (!hit || hit_t < t))
+	{
+		t = hit_t;
+		hit = true;
+	}
+	return hit;
+}
+
+/* Walk the tree front to back: a node is only opened when the ray crosses its box before the nearest hit so far, and only leaf cells test triangles. */
+bool TerrainQuadtree::raycast(const float * heights, glm::vec3 origin, glm::vec3 direction, float max_t, float &t)
+{
+	if (levels.empty())
+		return false;
+	//Axis-parallel rays divide by a tiny number instead of zero so the slab tests never see 0 * inf.
+	glm::vec3 inverse;
+	for (int c = 0; c < 3; c++)
+	{
+		float d = direction[c];
+		if (fabs(d) < RAY_EPSILON)
+			d = (d < 0.0f) ? -RAY_EPSILON : RAY_EPSILON;
+		inverse[c] = 1.0f / d;
+	}
+	//Nodes still to visit as (level, x, z, entry t), at most three siblings are waiting per level.
+	struct Node {
+		int level, x, z;
+		float enter;
+	};
+	Node stack[MAX_DEPTH * 4];
+	int top = 0;
+	float best = max_t;
+	bool hit = false;
+	stack[top++] = { (int)levels.size() - 1, 0, 0, 0.0f };
+	while (top > 0)
+	{
+		Node node = stack[--top];
+		if (node.enter > best)
+			continue;
+		if (node.level == 0)
+		{
+			float cell_t;
+			if (hitCell(heights, node.x, node.z, origin, direction, cell_t) && cell_t <= best)
+			{
+				best = cell_t;
+				hit = true;
+			}
+			continue;
+		}
+		//Children that the ray enters, sorted so the nearest is popped first.
+		int child_level = node.level - 1;
+		int child_side = sides[child_level];
+		int span = 1 << child_level;
+		Node children[4];
+		int count = 0;
+		for (int k = 0; k < 4; k++)
+		{
+			int x = node.x * 2 + (k & 1);
+			int z = node.z * 2 + (k >> 1);
+			if (x >= child_side || z >= child_side)
+				continue;
+			glm::vec2 range = levels[child_level][z * child_side + x];
+			glm::vec3 lower(x * span * cell_size, range.x, z * span * cell_size);
+			glm::vec3 upper(glm::min((x + 1) * span, cells) * cell_size, range.y, glm::min((z + 1) * span, cells) * cell_size);
+			glm::vec3 t0 = (lower - origin) * inverse;
+			glm::vec3 t1 = (upper - origin) * inverse;
+			glm::vec3 near_t = glm::min(t0, t1);
+			glm::vec3 far_t = glm::max(t0, t1);
+			float enter = glm::max(glm::max(near_t.x, near_t.y), glm::max(near_t.z, 0.0f));
+			float exit = glm::min(glm::min(far_t.x, far_t.y), glm::min(far_t.z, best));
+			if (enter > exit)
+				continue;
+			Node child = { child_level, x, z, enter };
+			//Insertion sort, furthest first.
+			int n = count++;
+			while (n > 0 && children[n - 1].enter < enter)
+			{
+				children[n] = children[n - 1];
+				n--;
+			}
+			children[n] = child;
+		}
+		for (int n = 0; n < count; n++)
+		{
+			stack[top++] = children[n];
+		}
+	}
+	if (hit)
+		t = best;
+	return hit;
+}
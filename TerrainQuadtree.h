@@ -0,0 +1,38 @@
+#pragma once
+#ifndef TERRAINQUADTREE_H
+#define TERRAINQUADTREE_H
+
+#include "Window.h"
+#include "Definitions.h"
+
+/* Min/max heights of a terrain tile's cells, one level per halving: the first level is every cell, the last is the whole tile. Rays only descend into nodes whose box they cross, so a ray cast only tests the triangles of a few cells. */
+class TerrainQuadtree
+{
+private:
+	//(min, max) of every node, level by level and row by row inside a level.
+	std::vector<std::vector<glm::vec2>> levels;
+	std::vector<int> sides;
+	//Cells per side (vertex_count - 1) and the width of a cell.
+	int cells;
+	int vertex_count;
+	float cell_size;
+	//Refit the cells [cx0, cx1) x [cz0, cz1) from the heights, then their parents.
+	void refit(const float * heights, int cx0, int cz0, int cx1, int cz1);
+	//Ray against the two triangles of cell (cx, cz), split the same way as Terrain::getHeightAt.
+	bool hitCell(const float * heights, int cx, int cz, glm::vec3 origin, glm::vec3 direction, float &t);
+	bool hitTriangle(glm::vec3 a, glm::vec3 b, glm::vec3 c, glm::vec3 origin, glm::vec3 direction, float &t);
+
+public:
+	TerrainQuadtree();
+	//Build every level from the heights, vertex_count * vertex_count row by row.
+	void build(const float * heights, int vertex_count, float cell_size);
+	//The heights of vertices [x0, x1) x [z0, z1) changed, refit the nodes that cover them.
+	void update(const float * heights, int x0, int z0, int x1, int z1);
+	//Nearest hit within [0, max_t] of a ray in the tile's local space, direction doesn't need to be normalized.
+	bool raycast(const float * heights, glm::vec3 origin, glm::vec3 direction, float max_t, float &t);
+	//Boxes of the nodes on the first level with at most max_side nodes per side, moved by offset into world space.
+	void getBoxes(int max_side, glm::vec3 offset, std::vector<AABB> &boxes);
+	//(min, max) height of the whole tile.
+	glm::vec2 getRange();
+};
+#endif
@@ -0,0 +1,174 @@
+#include "TextureCache.h"
+
+std::map<std::string, TextureCache::Entry> TextureCache::textures;
+
+/* Return the cached texture and add a reference to it. */
+GLuint TextureCache::find(const std::string &key)
+{
+	std::map<std::string, Entry>::iterator it = textures.find(key);
+	if (it == textures.end())
+	{
+		return 0;
+	}
+	it->second.references++;
+	return it->second.id;
+}
+
+/** Load a ppm file from disk.
+@input filename The location of the PPM file.  If the file is not found, an error message
+will be printed and this function will return 0
+@input width This will be modified to contain the width of the loaded image, or 0 if file not found
+@input height This will be modified to contain the height of the loaded image, or 0 if file not found
+@return Returns the RGB pixel data as interleaved unsigned chars (R0 G0 B0 R1 G1 B1 R2 G2 B2 .... etc) or 0 if an error ocured
+**/
+unsigned char* TextureCache::loadPPM(const char* filename, int& width, int& height)
+{
+	const int BUFSIZE = 128;
+	FILE* fp;
+	unsigned int read;
+	unsigned char* rawData;
+	char buf[3][BUFSIZE];
+	char* retval_fgets;
+	size_t retval_sscanf;
+	//Read in the ppm file.
+	if ((fp = fopen(filename, "rb")) == NULL)
+	{
+		std::cerr << "error reading ppm file, could not locate " << filename << std::endl;
+		width = 0;
+		height = 0;
+		return NULL;
+	}
+	//Read magic number:
+	retval_fgets = fgets(buf[0], BUFSIZE, fp);
+	//Read width and height:
+	do
+	{
+		retval_fgets = fgets(buf[0], BUFSIZE, fp);
+	} while (buf[0][0] == '#');
+	retval_sscanf = sscanf(buf[0], "%s %s", buf[1], buf[2]);
+	width = atoi(buf[1]);
+	height = atoi(buf[2]);
+	//Read maxval:
+	do
+	{
+		retval_fgets = fgets(buf[0], BUFSIZE, fp);
+	} while (buf[0][0] == '#');
+	//Read image data:
+	rawData = new unsigned char[width * height * 3];
+	read = (unsigned int)fread(rawData, width * height * 3, 1, fp);
+	fclose(fp);
+	if (read != 1)
+	{
+		std::cerr << "error parsing ppm file, incomplete data" << std::endl;
+		delete[] rawData;
+		width = 0;
+		height = 0;
+		return NULL;
+	}
+	return rawData;//Return rawData or 0 if failed.
+}
+
+/* Load a 2D texture, or return the one already loaded from this file. */
+GLuint TextureCache::loadTexture(const char* filename)
+{
+	//Check if we already have this texture.
+	std::string key = filename;
+	GLuint textureID = find(key);
+	if (textureID != 0)
+	{
+		return textureID;
+	}
+	//Define variables to hold height map's width, height, pixel information.
+	int width, height;
+	unsigned char * image;
+	//Create ID for texture.
+	glGenTextures(1, &textureID);
+	//Set the active texture ID.
+	glActiveTexture(GL_TEXTURE0);
+	//Set this texture to be the one we are working with.
+	glBindTexture(GL_TEXTURE_2D, textureID);
+	//Make sure no bytes are padded:
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	//Generate the texture.
+	image = loadPPM(filename, width, height);//Load the ppm file.
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
+	delete[] image;
+	//Use bilinear interpolation:
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	//Use clamp to edge:
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);//X
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);//Y
+	//Unbind the texture.
+	glBindTexture(GL_TEXTURE_2D, 0);
+	//Keep track of it for the next caller.
+	Entry entry = { textureID, 1 };
+	textures[key] = entry;
+	return textureID;
+}
+
+/* Load the cube map and return a texture ID, or return the one already loaded from these faces. */
+GLuint TextureCache::loadCubemap(std::vector<const GLchar*> faces)
+{
+	//The key is every face, in order.
+	std::string key = "cubemap";
+	for (GLuint i = 0; i < faces.size(); i++)
+	{
+		key += "|";
+		key += faces[i];
+	}
+	GLuint textureID = find(key);
+	if (textureID != 0)
+	{
+		return textureID;
+	}
+	//Define variables to hold height map's width, height, pixel information.
+	int width, height;
+	unsigned char * image;
+	//Create ID for texture.
+	glGenTextures(1, &textureID);
+	glActiveTexture(GL_TEXTURE0);//Set this texture to be the active texture (0).
+	//Set this texture to be the one we are working with.
+	glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+	//Make sure no bytes are padded:
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	//Generate the texture.
+	for (GLuint i = 0; i < faces.size(); i++)
+	{
+		image = loadPPM(faces[i], width, height);
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
+		delete[] image;
+	}
+	//Select GL_MODULATE to mix texture with polygon color for shading:
+	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+	//Use bilinear interpolation:
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	//Use clamp to edge to hide skybox edges:
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);//X
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);//Y
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);//Z
+	//Unbind the texture cube map.
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	//Keep track of it for the next caller.
+	Entry entry = { textureID, 1 };
+	textures[key] = entry;
+	return textureID;
+}
+
+/* Drop a reference to the texture and delete it once nothing uses it. */
+void TextureCache::release(GLuint textureID)
+{
+	for (std::map<std::string, Entry>::iterator it = textures.begin(); it != textures.end(); ++it)
+	{
+		if (it->second.id != textureID)
+			continue;
+		it->second.references--;
+		if (it->second.references == 0)
+		{
+			glDeleteTextures(1, &textureID);
+			textures.erase(it);
+		}
+		return;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include "Window.h"
+#include <map>
+#include <string>
+
+/* Textures keyed by the file(s) they were loaded from. Loading the same path again returns the same GL texture and adds a reference. */
+class TextureCache
+{
+private:
+	//A loaded texture and how many users it has.
+	struct Entry {
+		GLuint id;
+		int references;
+	};
+	static std::map<std::string, Entry> textures;
+	//Return the cached texture for key and add a reference, or 0 if it hasn't been loaded.
+	static GLuint find(const std::string &key);
+	static unsigned char* loadPPM(const char* filename, int& width, int& height);
+
+public:
+	//Load a 2D texture (terrain textures, blend maps) or a cube map (skybox faces).
+	static GLuint loadTexture(const char* filename);
+	static GLuint loadCubemap(std::vector<const GLchar*> faces);
+	//Drop a reference, the texture is deleted with the last one.
+	static void release(GLuint textureID);
+};
+#endif
@@ -0,0 +1,97 @@
+#include "ThreadPool.h"
+
+/* Start the workers. Defaults to the number of hardware threads. */
+ThreadPool::ThreadPool(unsigned int threads)
+{
+	this->stop = false;
+	if (threads == 0)
+	{
+		threads = std::thread::hardware_concurrency();
+	}
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		workers.push_back(std::thread(&ThreadPool::work, this));
+	}
+}
+
+/* Deconstructor finishes any queued jobs, then joins the workers. */
+ThreadPool::~ThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(queue_mutex);
+		stop = true;
+	}
+	condition.notify_all();
+	for (std::thread &worker : workers)
+	{
+		worker.join();
+	}
+}
+
+/* Pull jobs off the queue until the pool is stopped and the queue is empty. */
+void ThreadPool::work()
+{
+	while (true)
+	{
+		std::packaged_task<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(queue_mutex);
+			condition.wait(lock, [this] { return stop || !jobs.empty(); });
+			if (stop && jobs.empty())
+				return;
+			job = std::move(jobs.front());
+			jobs.pop();
+		}
+		job();
+	}
+}
+
+/* Queue a job for the workers. */
+std::future<void> ThreadPool::enqueue(std::function<void()> job)
+{
+	std::packaged_task<void()> task(job);
+	std::future<void> result = task.get_future();
+	{
+		std::unique_lock<std::mutex> lock(queue_mutex);
+		jobs.push(std::move(task));
+	}
+	condition.notify_one();
+	return result;
+}
+
+/* Split [begin, end) into one chunk per worker and wait for all of them. */
+void ThreadPool::parallel_for(int begin, int end, std::function<void(int)> job)
+{
+	int count = end - begin;
+	if (count <= 0)
+		return;
+	int chunks = (int)workers.size();
+	if (chunks > count)
+		chunks = count;
+	int chunk_size = (count + chunks - 1) / chunks;
+	std::vector<std::future<void>> results;
+	for (int start = begin; start < end; start += chunk_size)
+	{
+		int stop_at = (start + chunk_size < end) ? start + chunk_size : end;
+		results.push_back(enqueue([=] {
+			for (int i = start; i < stop_at; i++)
+			{
+				job(i);
+			}
+		}));
+	}
+	for (std::future<void> &result : results)
+	{
+		result.get();
+	}
+}
+
+/* Return the number of workers. */
+unsigned int ThreadPool::size()
+{
+	return (unsigned int)workers.size();
+}
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+/* Fixed pool of worker threads. Jobs must never touch OpenGL, all GL calls stay on the main thread. */
+class ThreadPool
+{
+private:
+	//Workers and the queue of jobs they pull from.
+	std::vector<std::thread> workers;
+	std::queue<std::packaged_task<void()>> jobs;
+	//Synchronization.
+	std::mutex queue_mutex;
+	std::condition_variable condition;
+	bool stop;
+	//Loop that every worker runs.
+	void work();
+
+public:
+	//Constructor methods. Passing 0 uses every core available.
+	ThreadPool(unsigned int threads = 0);
+	~ThreadPool();
+	//Queue a job, the returned future is ready once the job has run.
+	std::future<void> enqueue(std::function<void()> job);
+	//Run job(i) for every i in [begin, end) split into chunks across the workers, returns when all are done.
+	void parallel_for(int begin, int end, std::function<void(int)> job);
+	//Number of workers.
+	unsigned int size();
+};
+#endif
@@ -10,31 +10,17 @@
 #define Water_h
 
 #include "Window.h"
-
-//A struct to hold a control point of the surface.
-struct Point {
-	float x;
-	float y;
-	float z;
-};
+#include "Definitions.h"
+#include "WaterMesh.h"
 
 class Water
 {
 private:
-	//Water properties.
-	std::vector<glm::vec3> vertices;
-	std::vector<glm::vec3> normals;
-	std::vector<int> indices;
-	unsigned int level_of_detail;
+	//The surface is shared by every tile, each tile is one instance of it.
+	WaterMesh * mesh;
 	//GLSL properties.
 	int draw_mode;
 	glm::mat4 toWorld;
-	GLuint VBO, VAO, EBO, VBONORM;
-	//Intialization functions.
-	void setupGeometry();
-	Point CalculateU(float t, int row);
-	Point CalculateV(float t, Point* pnts);
-	Point Calculate(float u, float v);
 	void setupWater();
 
 public:
@@ -42,13 +28,17 @@ public:
 	Water(int x_d, int z_d, GLuint skyBox_texture);
     ~Water();
 
-	//Determine the Water's position in the world.
+	//Determine the Water's position in the world.
 	int x, z;
 
 	GLuint skyTexture;
 
-	void toggleDrawMode();
+	void toggleDrawMode();
 	void draw(GLuint);
+	//Draw many tiles with one instanced call at the given time. They share the draw mode and sky of the first. With an ocean, the tiles show it instead of the ripples.
+	static void draw(GLuint shaderProgram, const std::vector<Water*> &waters, float time, Ocean * ocean);
+	//World space box around the surface and its ripples, for culling.
+	AABB getBounds();
 };
 
 #endif
@@ -0,0 +1,183 @@
+#include "WaterMesh.h"
+
+#define HEIGHT 3
+#define WATER_SIZE 150
+#define LEVEL_OF_DETAIL 300
+#define DRAW_SHADED 0
+#define DRAW_WIREFRAME 1
+
+WaterMesh * WaterMesh::shared = nullptr;
+int WaterMesh::references = 0;
+
+/// 4x4 grid of points that will define the surface
+glm::vec3 Points[4][4] = {
+    {
+        { (2 * WATER_SIZE), HEIGHT, (2 * WATER_SIZE) },
+		{ WATER_SIZE, HEIGHT, (2 * WATER_SIZE) },
+		{ -WATER_SIZE, HEIGHT, (2 * WATER_SIZE) },
+        {-(2*WATER_SIZE), HEIGHT, (2*WATER_SIZE) }
+    },
+    {
+        { (2*WATER_SIZE), HEIGHT, WATER_SIZE },
+        {  WATER_SIZE, HEIGHT, WATER_SIZE },
+        { -WATER_SIZE, HEIGHT, WATER_SIZE },
+        {-(2*WATER_SIZE), HEIGHT, WATER_SIZE }
+    },
+    {
+        { (2*WATER_SIZE), HEIGHT, -WATER_SIZE },
+        {  WATER_SIZE, HEIGHT, -WATER_SIZE },
+        { -WATER_SIZE, HEIGHT, -WATER_SIZE },
+        {-(2*WATER_SIZE), HEIGHT, -WATER_SIZE }
+    },
+    {
+        { (2*WATER_SIZE), HEIGHT,-(2*WATER_SIZE) },
+        {  WATER_SIZE, HEIGHT,-(2*WATER_SIZE) },
+        { -WATER_SIZE, HEIGHT,-(2*WATER_SIZE) },
+        {-(2*WATER_SIZE), HEIGHT, -(2*WATER_SIZE) }
+    }
+};
+
+/* Evaluate the surface and upload it. The CPU copies are dropped once they're on the GPU. */
+WaterMesh::WaterMesh(unsigned int level_of_detail)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<unsigned int> indices;
+	indices.reserve((level_of_detail - 1) * (level_of_detail - 1) * 6);
+	/* Setting up verticies, vertex i * level_of_detail + j is at (u_i, v_j). */
+	BezierPatch patch(Points);
+	patch.tessellate(level_of_detail, vertices);
+	/* Setting up indices. */
+	for (unsigned int gx = 0; gx < level_of_detail - 1; gx++)
+	{
+		for (unsigned int gz = 0; gz < level_of_detail - 1; gz++)
+		{
+			unsigned int topLeft = (gx*level_of_detail) + gz;
+			unsigned int topRight = ((gx + 1)*level_of_detail) + gz;
+			unsigned int bottomLeft = topLeft + 1;
+			unsigned int bottomRight = topRight + 1;
+			//Push back to indices.
+			indices.push_back(topLeft);
+			indices.push_back(bottomLeft);
+			indices.push_back(topRight);
+			indices.push_back(topRight);
+			indices.push_back(bottomLeft);
+			indices.push_back(bottomRight);
+		}
+	}
+	this->index_count = (GLsizei)indices.size();
+	this->instance_capacity = 0;
+	//Create buffers/arrays
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+	glGenBuffers(1, &INSTANCES);
+	glBindVertexArray(VAO);
+	//Vertices.
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), &vertices[0], GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
+	glEnableVertexAttribArray(0);
+	//The surface is flat before the shader's ripples, so the normal is a constant attribute set in draw instead of a buffer.
+	glDisableVertexAttribArray(1);
+	//One offset per instance.
+	glBindBuffer(GL_ARRAY_BUFFER, INSTANCES);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
+	glEnableVertexAttribArray(2);
+	glVertexAttribDivisor(2, 1);
+	//Indices.
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+/* Deconstructor to safely delete when finished. */
+WaterMesh::~WaterMesh()
+{
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &EBO);
+	glDeleteBuffers(1, &INSTANCES);
+}
+
+/* Return the shared mesh and add a reference to it. */
+WaterMesh * WaterMesh::acquire()
+{
+	if (shared == nullptr)
+	{
+		shared = new WaterMesh(LEVEL_OF_DETAIL);
+	}
+	references++;
+	return shared;
+}
+
+/* Drop a reference, the mesh is deleted with the last one. */
+void WaterMesh::release()
+{
+	references--;
+	if (references == 0)
+	{
+		delete(shared);
+		shared = nullptr;
+	}
+}
+
+/* Set the uniforms, textures and polygon mode every water draw shares. */
+void WaterMesh::bind(GLuint shaderProgram, float time, int draw_mode, GLuint skyTexture, Ocean * ocean)
+{
+	glm::mat4 PV = Window::P * Window::V;
+	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "PV"), 1, GL_FALSE, &PV[0][0]);
+	glUniform3f(glGetUniformLocation(shaderProgram, "viewPos"), Window::camera_pos.x, Window::camera_pos.y, Window::camera_pos.z);
+	glUniform1f(glGetUniformLocation(shaderProgram, "time"), time);
+	//Update toon_shade.
+	glUniform1i(glGetUniformLocation(shaderProgram, "toon_shade"), Window::toon_shading);
+	//The ocean's maps go on units 1 and 2, the sky stays on 0. The samplers are always pointed there since a 2D and a cube sampler can't share a unit.
+	glUniform1i(glGetUniformLocation(shaderProgram, "ocean"), ocean != nullptr);
+	glUniform1i(glGetUniformLocation(shaderProgram, "displacement_map"), 1);
+	glUniform1i(glGetUniformLocation(shaderProgram, "normal_map"), 2);
+	if (ocean != nullptr)
+	{
+		glUniform1f(glGetUniformLocation(shaderProgram, "patch_length"), ocean->getPatchLength());
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, ocean->getDisplacementMap());
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_2D, ocean->getNormalMap());
+		glActiveTexture(GL_TEXTURE0);
+	}
+	//Set draw_mode to view wireframe version or filled version.
+	if (draw_mode == DRAW_SHADED)
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	}
+	else if (draw_mode == DRAW_WIREFRAME)
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	}
+	glUniform1i(glGetUniformLocation(shaderProgram, "projected"), false);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, skyTexture);
+}
+
+/* Upload the offsets and draw every instance at once. */
+void WaterMesh::draw(GLuint shaderProgram, const std::vector<glm::vec3> &offsets, float time, int draw_mode, GLuint skyTexture, Ocean * ocean)
+{
+	if (offsets.empty())
+		return;
+	//The model matrix is just each instance's offset, added in the shader.
+	WaterMesh::bind(shaderProgram, time, draw_mode, skyTexture, ocean);
+	//Replace the offsets, growing the buffer only when there are more than ever before.
+	glBindBuffer(GL_ARRAY_BUFFER, INSTANCES);
+	if ((GLsizei)offsets.size() > instance_capacity)
+	{
+		instance_capacity = (GLsizei)offsets.size();
+		glBufferData(GL_ARRAY_BUFFER, instance_capacity * sizeof(glm::vec3), NULL, GL_STREAM_DRAW);
+	}
+	glBufferSubData(GL_ARRAY_BUFFER, 0, offsets.size() * sizeof(glm::vec3), &offsets[0]);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	//Bind for drawing.
+	glBindVertexArray(VAO);
+	glVertexAttrib3f(1, 0.0f, 1.0f, 0.0f);
+	glDrawElementsInstanced(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, 0, (GLsizei)offsets.size());
+	glBindVertexArray(0);
+	//Set it back to fill.
+	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+}
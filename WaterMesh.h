@@ -0,0 +1,33 @@
+#pragma once
+#ifndef WATERMESH_H
+#define WATERMESH_H
+
+#include "Window.h"
+#include "Definitions.h"
+#include "BezierPatch.h"
+#include "Ocean.h"
+
+/* The Bezier surface every water tile is drawn with. It's the same for every tile, so it's evaluated and uploaded once and each tile is an instance moved by its offset. */
+class WaterMesh
+{
+private:
+	//One shared instance, deleted when the last water releases it.
+	static WaterMesh * shared;
+	static int references;
+	WaterMesh(unsigned int level_of_detail);
+	~WaterMesh();
+	//GLSL properties. INSTANCES holds one offset per tile drawn.
+	GLuint VAO, VBO, EBO, INSTANCES;
+	GLsizei index_count;
+	GLsizei instance_capacity;
+
+public:
+	//Get the shared mesh, creating it on first use. Must run on the GL thread.
+	static WaterMesh * acquire();
+	static void release();
+	//Draw one instance of the surface per offset, in a single call. time drives the ripples, or the surface is displaced by ocean's maps when it isn't nullptr.
+	void draw(GLuint shaderProgram, const std::vector<glm::vec3> &offsets, float time, int draw_mode, GLuint skyTexture, Ocean * ocean);
+	//Set what every water draw shares: the camera, time, draw mode, sky and the ocean's maps.
+	static void bind(GLuint shaderProgram, float time, int draw_mode, GLuint skyTexture, Ocean * ocean);
+};
+#endif
@@ -0,0 +1,153 @@
+#include "WaveModel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WAVE_SSE
+#endif
+
+//The shader's constants, PI included, so the heights match what's drawn.
+#define AMPLITUDE 0.3f
+#define FREQUENCY 10.0f
+#define SHADER_PI 3.14159f
+//Water surface height and tile size, as in Water.cpp.
+#define HEIGHT 3.0f
+#define SIZE 500.0f
+
+WaveModel::WaveModel()
+{
+	this->time = 0.0f;
+}
+
+/* Set the time the waves are sampled at. */
+void WaveModel::setTime(float time)
+{
+	this->time = time;
+}
+
+/* Work out the shader's phase at position. Every tile's mesh is centered on its tile and the surface's vertices are HEIGHT above that center. */
+float WaveModel::getPhase(glm::vec3 position, glm::vec2 &local, float &distance)
+{
+	local.x = position.x - (floor(position.x / SIZE) * SIZE + SIZE / 2);
+	local.y = position.z - (floor(position.z / SIZE) * SIZE + SIZE / 2);
+	distance = sqrt(local.x * local.x + HEIGHT * HEIGHT + local.y * local.y);
+	return -SHADER_PI * distance * FREQUENCY + time;
+}
+
+/* Return the height of the water surface above (or below) position. */
+float WaveModel::sampleHeight(glm::vec3 position)
+{
+	glm::vec2 local;
+	float distance;
+	float phase = getPhase(position, local, distance);
+	float y = AMPLITUDE * sin(phase) + AMPLITUDE * cos(phase);
+	return HEIGHT - y * 0.5f;
+}
+
+/* Return the normal of the water surface at position. The slope along x is 0.5 * amplitude * PI * frequency * (cos - sin) * x / d, z is the same. */
+glm::vec3 WaveModel::sampleNormal(glm::vec3 position)
+{
+	glm::vec2 local;
+	float distance;
+	float phase = getPhase(position, local, distance);
+	float slope = 0.5f * AMPLITUDE * SHADER_PI * FREQUENCY * (cos(phase) - sin(phase)) / distance;
+	return glm::normalize(glm::vec3(-slope * local.x, 1.0f, -slope * local.y));
+}
+
+#ifdef WAVE_SSE
+/* Sine and cosine of four angles. The angle is reduced to [-pi/4, pi/4] around the nearest multiple of pi/2 (split in three so large phases keep their precision), then polynomials from Cephes give both and the quadrant picks and signs them. */
+static void sincos_ps(__m128 x, __m128 &sine, __m128 &cosine)
+{
+	__m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(0.63661977236f)));
+	__m128 k = _mm_cvtepi32_ps(quadrant);
+	__m128 r = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(1.5703125f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(4.837512969970703125e-4f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(7.54978995489188216e-8f)));
+	__m128 z = _mm_mul_ps(r, r);
+	//sin(r) = r + r^3 * (s1 + z * (s2 + z * s3)).
+	__m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+	s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(-1.6666654611e-1f));
+	s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), r), r);
+	//cos(r) = 1 - z / 2 + z^2 * (c1 + z * (c2 + z * c3)).
+	__m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+	c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+	c = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(c, z), z), _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(z, _mm_set1_ps(0.5f))));
+	//Odd quadrants swap sine and cosine, then quadrants 2 and 3 negate sine and 1 and 2 negate cosine.
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128 sine_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+	__m128 cosine_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+	sine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s)), sine_sign);
+	cosine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c)), cosine_sign);
+}
+
+/* floor for four floats, SSE2 has no round instruction. */
+static __m128 floor_ps(__m128 x)
+{
+	__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+	return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, x), _mm_set1_ps(1.0f)));
+}
+
+/* The phase at four positions, and their tile-local x, z and distance. */
+static __m128 getPhase_ps(const glm::vec3 * positions, float time, __m128 &local_x, __m128 &local_z, __m128 &distance)
+{
+	__m128 x = _mm_setr_ps(positions[0].x, positions[1].x, positions[2].x, positions[3].x);
+	__m128 z = _mm_setr_ps(positions[0].z, positions[1].z, positions[2].z, positions[3].z);
+	__m128 size = _mm_set1_ps(SIZE);
+	__m128 half = _mm_set1_ps(SIZE / 2);
+	local_x = _mm_sub_ps(x, _mm_add_ps(_mm_mul_ps(floor_ps(_mm_div_ps(x, size)), size), half));
+	local_z = _mm_sub_ps(z, _mm_add_ps(_mm_mul_ps(floor_ps(_mm_div_ps(z, size)), size), half));
+	__m128 length_2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(local_x, local_x), _mm_set1_ps(HEIGHT * HEIGHT)), _mm_mul_ps(local_z, local_z));
+	distance = _mm_sqrt_ps(length_2);
+	return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(-SHADER_PI), distance), _mm_set1_ps(FREQUENCY)), _mm_set1_ps(time));
+}
+#endif
+
+/* Return the water height at every position. */
+void WaveModel::sampleHeights(const glm::vec3 * positions, int count, float * heights)
+{
+	int n = 0;
+#ifdef WAVE_SSE
+	for (; n + 4 <= count; n += 4)
+	{
+		__m128 local_x, local_z, distance, sine, cosine;
+		__m128 phase = getPhase_ps(positions + n, time, local_x, local_z, distance);
+		sincos_ps(phase, sine, cosine);
+		__m128 amplitude = _mm_set1_ps(AMPLITUDE);
+		__m128 y = _mm_add_ps(_mm_mul_ps(amplitude, sine), _mm_mul_ps(amplitude, cosine));
+		_mm_storeu_ps(heights + n, _mm_sub_ps(_mm_set1_ps(HEIGHT), _mm_mul_ps(y, _mm_set1_ps(0.5f))));
+	}
+#endif
+	for (; n < count; n++)
+	{
+		heights[n] = sampleHeight(positions[n]);
+	}
+}
+
+/* Return the water normal at every position. */
+void WaveModel::sampleNormals(const glm::vec3 * positions, int count, glm::vec3 * normals)
+{
+	int n = 0;
+#ifdef WAVE_SSE
+	for (; n + 4 <= count; n += 4)
+	{
+		__m128 local_x, local_z, distance, sine, cosine;
+		__m128 phase = getPhase_ps(positions + n, time, local_x, local_z, distance);
+		sincos_ps(phase, sine, cosine);
+		__m128 slope = _mm_div_ps(_mm_mul_ps(_mm_set1_ps(0.5f * AMPLITUDE * SHADER_PI * FREQUENCY), _mm_sub_ps(cosine, sine)), distance);
+		__m128 normal_x = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(slope, local_x));
+		__m128 normal_z = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(slope, local_z));
+		__m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normal_x, normal_x), _mm_set1_ps(1.0f)), _mm_mul_ps(normal_z, normal_z))));
+		float x[4], y[4], z[4];
+		_mm_storeu_ps(x, _mm_mul_ps(normal_x, inverse));
+		_mm_storeu_ps(y, inverse);
+		_mm_storeu_ps(z, _mm_mul_ps(normal_z, inverse));
+		for (int k = 0; k < 4; k++)
+		{
+			normals[n + k] = glm::vec3(x[k], y[k], z[k]);
+		}
+	}
+#endif
+	for (; n < count; n++)
+	{
+		normals[n] = sampleNormal(positions[n]);
+	}
+}
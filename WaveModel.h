@@ -0,0 +1,27 @@
+#pragma once
+#ifndef WAVEMODEL_H
+#define WAVEMODEL_H
+
+#include "Window.h"
+
+/* The ripples water.vert draws, worked out on the CPU so gameplay can ask how high the water is. Each tile ripples out from its own center: with d the distance from the center (including the surface's height above it) and
+	y = amplitude * (sin(-PI * d * frequency + time) + cos(-PI * d * frequency + time))
+the surface sits at HEIGHT - y / 2. Normals come from the analytic gradient of the same function. */
+class WaveModel
+{
+private:
+	float time;
+	//Phase of the wave at position and how far it is from its tile's center, the same as the shader's dist.
+	float getPhase(glm::vec3 position, glm::vec2 &local, float &distance);
+
+public:
+	WaveModel();
+	//Seconds since start, the same time the water was last drawn with.
+	void setTime(float time);
+	float sampleHeight(glm::vec3 position);
+	glm::vec3 sampleNormal(glm::vec3 position);
+	//Batched versions, four positions at a time. Only x and z of each position are used.
+	void sampleHeights(const glm::vec3 * positions, int count, float * heights);
+	void sampleNormals(const glm::vec3 * positions, int count, glm::vec3 * normals);
+};
+#endif
@@ -1,11 +1,11 @@
 #ifndef WINDOW_H
 #define WINDOW_H
 
-#include <GL/glew.h>
-#include <GLFW/glfw3.h>
-#include <glm/mat4x4.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <iostream>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
 #include <fstream>
 #include <stdlib.h>
 #include <stdio.h>
@@ -47,7 +47,7 @@ public:
 	static void updateCamera(glm::vec3 e, glm::vec3 d, glm::vec3 up);
 	static void redrawScene();
 
-	static float lastFrameTime;
+	static float lastFrameTime;
 	static float delta;
 
 	static bool toon_shading;
@@ -57,6 +57,7 @@ public:
 	static void drawWater();
 	static void drawParticles();
 	static void drawCollision();
+	static void drawObjects();
 
 	static int draw_mode;
 
@@ -9,14 +9,14 @@ layout (location = 2) in vec2 texCoords;
 
 //Define uniform MVP: model, view, projection passed from the object.
 uniform mat4 MVP;
-uniform mat4 model;
-uniform mat4 view;
+uniform mat4 model;
+uniform mat4 view;
 uniform mat4 projection;
 uniform vec3 lightPos;
 
 //Define any out variables for the fragment shader.
-out vec3 FragPos;
-out vec3 FragNormal;
+out vec3 FragPos;
+out vec3 FragNormal;
 out vec2 FragTexCoords;
 out float visibility;
 
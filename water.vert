@@ -1,36 +1,81 @@
-#version 330 core
-
-//The vertex shader gets called once per vertex.
-
-//Define position, normal, and texture defined in the Container.
-layout (location = 0) in vec3 vertex;
-layout (location = 1) in vec3 normal;
-
-
-//Define uniform MVP: model, view, projection passed from the object.
-uniform mat4 MVP;
-uniform mat4 model;
-uniform float time; //elasped time
-
-out vec3 FragNormal;
-out vec3 FragPos;
-
-//shader constants
-const float amplitude = 0.3;
-const float frequency = 10;
-const float PI = 3.14159;
-
-
-void main()
-{
-    /* Ripple Effect */
-    //Get the Euclidean distance of the current vertex from the center of the mesh
-    float dist = length(vertex);
-    //Create a sin/cos function using the distance, multiply frequency and add the elapsed time
-    float y = amplitude*sin(-PI*dist*frequency+time) +  amplitude*cos(-PI*dist*frequency+time);
-    //Multiply the MVP matrix with the new position to get the clipspace position.
-    gl_Position = MVP * vec4(vertex.x, vertex.y - y*.5, vertex.z, 1);
-	//Update variables to pass to the fragment shader.
-    FragPos = vec3(model * vec4(vertex.x, y, vertex.z, 1.0f));
-    FragNormal = vec3( mat4(transpose(inverse(model)))  * vec4(normal.x, normal.y, normal.z, 1.0f));
-}
+#version 330 core
+
+//The vertex shader gets called once per vertex.
+
+//Define position, normal, and texture defined in the Container.
+layout (location = 0) in vec3 vertex;
+layout (location = 1) in vec3 normal;
+//Center of the tile this instance is drawn for.
+layout (location = 2) in vec3 offset;
+
+
+//Define uniform PV: projection * view. The model matrix is only the instance's offset.
+uniform mat4 PV;
+uniform float time; //elasped time
+//FFT ocean: the surface is moved by the displacement map, which repeats every patch_length.
+uniform bool ocean;
+uniform sampler2D displacement_map;
+uniform float patch_length;
+//Projected grid: vertex.xy is a point on the grid, projector takes it out to world space and it's dropped onto the plane y = water_height.
+uniform bool projected;
+uniform mat4 projector;
+uniform float water_height;
+
+out vec3 FragNormal;
+out vec3 FragPos;
+out vec2 FragUV;
+
+//shader constants
+const float amplitude = 0.3;
+const float frequency = 10;
+const float PI = 3.14159;
+const float tile_size = 500;
+
+
+//Intersect the grid point's ray with the plane in homogeneous coordinates so the far away points stay finite. Rays that miss take the far point, dropped onto the plane by the horizon.
+vec3 projectGrid(vec2 grid)
+{
+    vec4 near = projector * vec4(grid, -1, 1);
+    vec4 far = projector * vec4(grid, 1, 1);
+    float near_height = near.y - water_height * near.w;
+    float far_height = far.y - water_height * far.w;
+    float t = 1;
+    if (near_height * far_height < 0)
+        t = near_height / (near_height - far_height);
+    vec4 point = mix(near, far, t);
+    return vec3(point.x / point.w, water_height, point.z / point.w);
+}
+
+void main()
+{
+    //Where the vertex is and the center of the tile it ripples around, the instance's or the one the projected vertex lands in.
+    vec3 position = vertex + offset;
+    vec3 center = offset;
+    if (projected)
+    {
+        position = projectGrid(vertex.xy);
+        vec2 tile = floor(position.xz / tile_size) * tile_size + tile_size / 2;
+        center = vec3(tile.x, 0, tile.y);
+    }
+    if (ocean)
+    {
+        FragUV = position.xz / patch_length;
+        position += textureLod(displacement_map, FragUV, 0).xyz;
+        gl_Position = PV * vec4(position, 1);
+        FragPos = position;
+        FragNormal = normal;
+        return;
+    }
+    FragUV = vec2(0);
+    /* Ripple Effect */
+    //Get the Euclidean distance of the current vertex from the center of the mesh
+    vec3 local = position - center;
+    float dist = length(local);
+    //Create a sin/cos function using the distance, multiply frequency and add the elapsed time
+    float y = amplitude*sin(-PI*dist*frequency+time) +  amplitude*cos(-PI*dist*frequency+time);
+    //Move the vertex to its tile and multiply by PV to get the clipspace position.
+    gl_Position = PV * vec4(position.x, position.y - y*.5, position.z, 1);
+	//Update variables to pass to the fragment shader. A translation leaves the normal as it is.
+    FragPos = vec3(local.x, y, local.z) + center;
+    FragNormal = normal;
+}